@@ -0,0 +1,192 @@
+#include "aad.h"
+
+#include <algorithm>
+#include <cmath>
+
+BlockTape& BlockTape::thread_tape() {
+    static thread_local BlockTape tape;
+    return tape;
+}
+
+void BlockTape::reset(std::size_t lanes) {
+    width = lanes;
+    count = 0;
+}
+
+std::uint32_t BlockTape::add_node(std::uint32_t a, std::uint32_t b) {
+    if (count == nodes.size()) {
+        // Grow geometrically; rewound storage is reused without clearing
+        const std::size_t capacity = std::max<std::size_t>(2 * nodes.size(), 64);
+        nodes.resize(capacity);
+        values.resize(capacity * width);
+        partials.resize(2 * capacity * width);
+    } else if (values.size() < nodes.size() * width) {
+        // Same node count as before but wider lanes
+        values.resize(nodes.size() * width);
+        partials.resize(2 * nodes.size() * width);
+    }
+    nodes[count].parent[0] = a;
+    nodes[count].parent[1] = b;
+    return static_cast<std::uint32_t>(count++);
+}
+
+std::uint32_t BlockTape::add_leaf(double value) {
+    const std::uint32_t node = add_node(kConstant, kConstant);
+    std::fill(values_of(node), values_of(node) + width, value);
+    return node;
+}
+
+std::uint32_t BlockTape::add_leaf(const double* lane_values) {
+    const std::uint32_t node = add_node(kConstant, kConstant);
+    std::copy(lane_values, lane_values + width, values_of(node));
+    return node;
+}
+
+std::uint32_t BlockTape::add(std::uint32_t a, std::uint32_t b) {
+    const std::uint32_t node = add_node(a, b);
+    const double* x = value(a);
+    const double* y = value(b);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    double* db = partial(node, 1);
+    for (std::size_t p = 0; p < width; ++p) {
+        v[p] = x[p] + y[p];
+        da[p] = 1.0;
+        db[p] = 1.0;
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::sub(std::uint32_t a, std::uint32_t b) {
+    const std::uint32_t node = add_node(a, b);
+    const double* x = value(a);
+    const double* y = value(b);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    double* db = partial(node, 1);
+    for (std::size_t p = 0; p < width; ++p) {
+        v[p] = x[p] - y[p];
+        da[p] = 1.0;
+        db[p] = -1.0;
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::mul(std::uint32_t a, std::uint32_t b) {
+    const std::uint32_t node = add_node(a, b);
+    const double* x = value(a);
+    const double* y = value(b);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    double* db = partial(node, 1);
+    for (std::size_t p = 0; p < width; ++p) {
+        v[p] = x[p] * y[p];
+        da[p] = y[p];
+        db[p] = x[p];
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::scale(std::uint32_t a, double c) {
+    const std::uint32_t node = add_node(a, kConstant);
+    const double* x = value(a);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    for (std::size_t p = 0; p < width; ++p) {
+        v[p] = c * x[p];
+        da[p] = c;
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::shift(std::uint32_t a, double c) {
+    const std::uint32_t node = add_node(a, kConstant);
+    const double* x = value(a);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    for (std::size_t p = 0; p < width; ++p) {
+        v[p] = x[p] + c;
+        da[p] = 1.0;
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::affine(std::uint32_t a, std::uint32_t b, const double* z) {
+    const std::uint32_t node = add_node(a, b);
+    const double* x = value(a);
+    const double* y = value(b);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    double* db = partial(node, 1);
+    for (std::size_t p = 0; p < width; ++p) {
+        v[p] = x[p] + y[p] * z[p];
+        da[p] = 1.0;
+        db[p] = z[p];
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::exp(std::uint32_t a) {
+    const std::uint32_t node = add_node(a, kConstant);
+    const double* x = value(a);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    for (std::size_t p = 0; p < width; ++p) {
+        v[p] = std::exp(x[p]);
+        da[p] = v[p];
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::mul_exp(std::uint32_t a, std::uint32_t b) {
+    const std::uint32_t node = add_node(a, b);
+    const double* x = value(a);
+    const double* y = value(b);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    double* db = partial(node, 1);
+    for (std::size_t p = 0; p < width; ++p) {
+        const double growth = std::exp(y[p]);
+        v[p] = x[p] * growth;
+        da[p] = growth;
+        db[p] = v[p];
+    }
+    return node;
+}
+
+std::uint32_t BlockTape::max(std::uint32_t a, double floor) {
+    const std::uint32_t node = add_node(a, kConstant);
+    const double* x = value(a);
+    double* v = values_of(node);
+    double* da = partial(node, 0);
+    for (std::size_t p = 0; p < width; ++p) {
+        const bool active = x[p] > floor;
+        v[p] = active ? x[p] : floor;
+        da[p] = active ? 1.0 : 0.0;
+    }
+    return node;
+}
+
+void BlockTape::reset_adjoints() {
+    if (adjoints.size() < count * width) {
+        adjoints.resize(nodes.size() * width);
+    }
+    std::fill(adjoints.begin(), adjoints.begin() + count * width, 0.0);
+}
+
+void BlockTape::propagate() {
+    for (std::size_t i = count; i-- > 0;) {
+        const Node& node = nodes[i];
+        const double* adj = &adjoints[i * width];
+        for (int k = 0; k < 2; ++k) {
+            if (node.parent[k] == kConstant) {
+                continue;
+            }
+            const double* d = partial(static_cast<std::uint32_t>(i), k);
+            double* target = &adjoints[node.parent[k] * width];
+            for (std::size_t p = 0; p < width; ++p) {
+                target[p] += d[p] * adj[p];
+            }
+        }
+    }
+}
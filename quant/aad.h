@@ -0,0 +1,98 @@
+#ifndef AAD_H
+#define AAD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Reverse-mode automatic differentiation tape over whole blocks of paths.
+ *
+ * Every node holds one value per lane (path) in structure-of-arrays layout,
+ * with the lane-wise partial derivatives to its parents, so one recorded
+ * operation covers every path of a block and both sweeps are straight loops
+ * over contiguous lanes. propagate() walks the tape backwards once and leaves
+ * d(output)/d(node) in every lane of every node's adjoint, so all input
+ * sensitivities of all paths cost one backward sweep. Inputs shared by all
+ * paths, such as a rate or a volatility, are leaves broadcast across the
+ * lanes; their adjoints come back per lane, that is per path. Nodes are
+ * identified by index, storage is kept across rewinds, and each thread
+ * records on its own tape.
+ */
+class BlockTape {
+public:
+    static const std::uint32_t kConstant = 0xFFFFFFFFu;   // Parent index of leaves and constant operands
+
+    // The calling thread's block tape
+    static BlockTape& thread_tape();
+
+    // Empties the tape and sets the number of lanes of every node
+    void reset(std::size_t lanes);
+
+    std::size_t lanes() const {
+        return width;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    // Drops every node after position; the storage is kept for reuse
+    void rewind(std::size_t position = 0) {
+        count = position;
+    }
+
+    // Leaves: every lane set to value, or lane values copied from values
+    std::uint32_t add_leaf(double value);
+    std::uint32_t add_leaf(const double* values);
+
+    // Lane-wise operations on nodes; each returns the node it records
+    std::uint32_t add(std::uint32_t a, std::uint32_t b);
+    std::uint32_t sub(std::uint32_t a, std::uint32_t b);
+    std::uint32_t mul(std::uint32_t a, std::uint32_t b);
+    std::uint32_t scale(std::uint32_t a, double c);                     // c * a
+    std::uint32_t shift(std::uint32_t a, double c);                     // a + c
+    std::uint32_t affine(std::uint32_t a, std::uint32_t b, const double* z);    // a + b * z, z per lane
+    std::uint32_t exp(std::uint32_t a);
+    std::uint32_t mul_exp(std::uint32_t a, std::uint32_t b);            // a * exp(b), one GBM step
+    std::uint32_t max(std::uint32_t a, double floor);                   // Derivative of the active branch
+
+    const double* value(std::uint32_t node) const {
+        return &values[node * width];
+    }
+
+    double* adjoint(std::uint32_t node) {
+        return &adjoints[node * width];
+    }
+
+    // Zeroes all adjoints; call before seeding an output
+    void reset_adjoints();
+
+    // Accumulates adjoints from the last node back to the first, lane by lane
+    void propagate();
+
+private:
+    struct Node {
+        std::uint32_t parent[2];
+    };
+
+    // Appends a node and returns its index; its lanes are left to the caller
+    std::uint32_t add_node(std::uint32_t a, std::uint32_t b);
+
+    double* values_of(std::uint32_t node) {
+        return &values[node * width];
+    }
+
+    double* partial(std::uint32_t node, int k) {
+        return &partials[(2 * node + k) * width];
+    }
+
+    std::size_t width = 0;
+    std::size_t count = 0;
+    std::vector<Node> nodes;
+    std::vector<double> values;     // values[node * width + lane]
+    std::vector<double> partials;   // partials[(2 * node + k) * width + lane], k = parent
+    std::vector<double> adjoints;
+};
+
+#endif // AAD_H
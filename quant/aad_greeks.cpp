@@ -0,0 +1,196 @@
+#include "aad_greeks.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "aad.h"
+#include "philox.h"
+#include "streaming_stats.h"
+
+namespace {
+
+// Paths recorded together on the block tape: one segment of a lane tile stays in L2
+const std::size_t kAadLanes = 128;
+
+// One accumulator per sensitivity, merged as a unit
+struct GreekSums {
+    std::vector<RunningStats> stats;
+
+    explicit GreekSums(int quantities = 0) : stats(static_cast<std::size_t>(quantities)) {}
+
+    void merge(const GreekSums& other) {
+        for (std::size_t q = 0; q < stats.size(); ++q) {
+            stats[q].merge(other.stats[q]);
+        }
+    }
+};
+
+Estimate to_estimate(const RunningStats& stats) {
+    Estimate estimate;
+    estimate.value = stats.mean();
+    estimate.std_error = stats.std_error();
+    estimate.num_paths = static_cast<std::size_t>(stats.count());
+    return estimate;
+}
+
+} // namespace
+
+AadGreeksResult price_european_aad(MonteCarloEngine& engine, const GbmParameters& params, OptionType type,
+                                   double strike, std::size_t num_paths, const std::vector<double>& sigma_buckets,
+                                   int checkpoint_interval) {
+    const int steps = std::max(params.steps, 1);
+    const double dt = params.T / steps;
+    const double sqrt_dt = std::sqrt(dt);
+    const double r = params.mu;
+    const double discount = std::exp(-r * params.T);
+    const std::vector<double> sigmas = sigma_buckets.empty() ? std::vector<double>(1, params.sigma) : sigma_buckets;
+    const int num_buckets = static_cast<int>(sigmas.size());
+    const int interval = std::min(std::max(checkpoint_interval, 1), steps);
+    const int num_segments = (steps + interval - 1) / interval;
+    const PathNormalGenerator normals(engine.seed(), 0, engine.isa());
+
+    // Step s belongs to bucket s * K / steps; the per-step constants are
+    // computed as advance_gbm_path does, so prices match it path for path
+    std::vector<int> bucket_of(steps);
+    for (int step = 0; step < steps; ++step) {
+        bucket_of[step] = step * num_buckets / steps;
+    }
+    std::vector<double> drift_dt(num_buckets), vol_sqrt_dt(num_buckets);
+    for (int k = 0; k < num_buckets; ++k) {
+        drift_dt[k] = (r - 0.5 * sigmas[k] * sigmas[k]) * dt;
+        vol_sqrt_dt[k] = sigmas[k] * sqrt_dt;
+    }
+
+    // Per reduction slot: price, delta, rho, vega, then one accumulator per bucket vega
+    const int kQuantities = 4 + num_buckets;
+    const std::size_t block_size = engine.block_size();
+    const std::size_t num_blocks = (num_paths + block_size - 1) / block_size;
+    std::vector<GreekSums> slots(engine.reduction_slots(num_paths), GreekSums(kQuantities));
+
+    engine.thread_pool().parallel_for(num_blocks, [&](std::size_t block, unsigned worker) {
+        const std::size_t block_begin = block * block_size;
+        const std::size_t block_end = std::min(block_begin + block_size, num_paths);
+        RunningStats* stats = slots[engine.reduction_slot(block_begin, worker)].stats.data();
+
+        BlockTape& tape = BlockTape::thread_tape();
+        std::vector<double> z(static_cast<std::size_t>(steps) * kAadLanes);    // z[step * lanes + p]
+        std::vector<double> checkpoints(static_cast<std::size_t>(num_segments) * kAadLanes);
+        std::vector<double> prices(kAadLanes), carried(kAadLanes), d_rate(kAadLanes);
+        std::vector<double> bucket_vega(static_cast<std::size_t>(num_buckets) * kAadLanes);
+        std::vector<std::uint32_t> sigma_nodes(num_buckets), drift_nodes(num_buckets), vol_nodes(num_buckets);
+
+        for (std::size_t begin = block_begin; begin < block_end; begin += kAadLanes) {
+            const std::size_t lanes = std::min(kAadLanes, block_end - begin);
+            normals.fill_block(begin, lanes, 0, static_cast<std::size_t>(steps), z.data());
+
+            // Forward pass in doubles across the lanes, keeping the prices at the start of every segment
+            std::fill(prices.begin(), prices.begin() + lanes, params.S0);
+            for (int segment = 0; segment < num_segments; ++segment) {
+                std::copy(prices.begin(), prices.begin() + lanes, &checkpoints[segment * lanes]);
+                const int last = std::min((segment + 1) * interval, steps);
+                for (int step = segment * interval; step < last; ++step) {
+                    const int k = bucket_of[step];
+                    const double* z_step = &z[step * lanes];
+                    for (std::size_t p = 0; p < lanes; ++p) {
+                        prices[p] = prices[p] * std::exp(drift_dt[k] + vol_sqrt_dt[k] * z_step[p]);
+                    }
+                }
+            }
+            bool any_in_the_money = false;
+            for (std::size_t p = 0; p < lanes; ++p) {
+                const double payoff = (type == OptionType::Call) ? std::max(prices[p] - strike, 0.0)
+                                                                 : std::max(strike - prices[p], 0.0);
+                stats[0].add(discount * payoff);
+                any_in_the_money = any_in_the_money || payoff > 0.0;
+            }
+
+            if (!any_in_the_money) {
+                // Out of the money everywhere: the payoff is flat in every input
+                for (int q = 1; q < kQuantities; ++q) {
+                    for (std::size_t p = 0; p < lanes; ++p) {
+                        stats[q].add(0.0);
+                    }
+                }
+                continue;
+            }
+
+            // Reverse pass over the whole tile, one segment at a time from the last back to the first.
+            // Out-of-the-money lanes get zero adjoints from the payoff's max.
+            std::fill(d_rate.begin(), d_rate.begin() + lanes, 0.0);
+            std::fill(bucket_vega.begin(), bucket_vega.begin() + num_buckets * lanes, 0.0);
+            for (int segment = num_segments - 1; segment >= 0; --segment) {
+                tape.reset(lanes);
+                const std::uint32_t start = tape.add_leaf(&checkpoints[segment * lanes]);
+                const std::uint32_t rate = tape.add_leaf(r);
+                std::fill(sigma_nodes.begin(), sigma_nodes.end(), BlockTape::kConstant);
+
+                // S_t = S_{t-1} * exp( (r - 0.5 * sigma^2) * dt + sigma * Z * sqrt(dt) ), with the
+                // bucket constants recorded the first time the segment reaches each bucket
+                std::uint32_t price = start;
+                const int last = std::min((segment + 1) * interval, steps);
+                for (int step = segment * interval; step < last; ++step) {
+                    const int k = bucket_of[step];
+                    if (sigma_nodes[k] == BlockTape::kConstant) {
+                        sigma_nodes[k] = tape.add_leaf(sigmas[k]);
+                        const std::uint32_t half_variance = tape.mul(tape.scale(sigma_nodes[k], 0.5), sigma_nodes[k]);
+                        drift_nodes[k] = tape.scale(tape.sub(rate, half_variance), dt);
+                        vol_nodes[k] = tape.scale(sigma_nodes[k], sqrt_dt);
+                    }
+                    price = tape.mul_exp(price, tape.affine(drift_nodes[k], vol_nodes[k], &z[step * lanes]));
+                }
+
+                if (segment == num_segments - 1) {
+                    const std::uint32_t intrinsic = (type == OptionType::Call)
+                                                  ? tape.shift(price, -strike)
+                                                  : tape.shift(tape.scale(price, -1.0), strike);
+                    const std::uint32_t value = tape.mul(tape.exp(tape.scale(rate, -params.T)),
+                                                         tape.max(intrinsic, 0.0));
+                    tape.reset_adjoints();
+                    std::fill(tape.adjoint(value), tape.adjoint(value) + lanes, 1.0);
+                } else {
+                    tape.reset_adjoints();
+                    std::copy(carried.begin(), carried.begin() + lanes, tape.adjoint(price));
+                }
+                tape.propagate();
+
+                std::copy(tape.adjoint(start), tape.adjoint(start) + lanes, carried.begin());
+                const double* rate_adjoint = tape.adjoint(rate);
+                for (std::size_t p = 0; p < lanes; ++p) {
+                    d_rate[p] += rate_adjoint[p];
+                }
+                for (int k = 0; k < num_buckets; ++k) {
+                    if (sigma_nodes[k] == BlockTape::kConstant) {
+                        continue;
+                    }
+                    const double* sigma_adjoint = tape.adjoint(sigma_nodes[k]);
+                    for (std::size_t p = 0; p < lanes; ++p) {
+                        bucket_vega[k * lanes + p] += sigma_adjoint[p];
+                    }
+                }
+            }
+
+            for (std::size_t p = 0; p < lanes; ++p) {
+                double vega = 0.0;
+                for (int k = 0; k < num_buckets; ++k) {
+                    stats[4 + k].add(bucket_vega[k * lanes + p]);
+                    vega += bucket_vega[k * lanes + p];
+                }
+                stats[1].add(carried[p]);
+                stats[2].add(d_rate[p]);
+                stats[3].add(vega);
+            }
+        }
+    });
+
+    const std::vector<RunningStats> totals = merge_pairwise(slots).stats;
+
+    AadGreeksResult result;
+    result.price = to_estimate(totals[0]);
+    result.delta = to_estimate(totals[1]);
+    result.rho = to_estimate(totals[2]);
+    result.vega = to_estimate(totals[3]);
+    for (int k = 0; k < num_buckets; ++k) {
+        result.bucket_vegas.push_back(to_estimate(totals[4 + k]));
+    }
+    return result;
+}
@@ -0,0 +1,249 @@
+#include "american_option.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "streaming_stats.h"
+
+namespace {
+
+// Paths per storage block: one date of one block is a 16-32 KB row
+const std::size_t kStorageBlock = 4096;
+
+const int kMaxBasis = 8;
+
+double exercise_value(OptionType type, double price, double strike) {
+    return (type == OptionType::Call) ? std::max(price - strike, 0.0) : std::max(strike - price, 0.0);
+}
+
+// Fills phi with 1, x, x^2, ..., x^(n - 1)
+inline void polynomial_basis(double x, int n, double* phi) {
+    phi[0] = 1.0;
+    for (int k = 1; k < n; ++k) {
+        phi[k] = phi[k - 1] * x;
+    }
+}
+
+/**
+ * @brief Solves the n x n symmetric system A beta = b in place by Cholesky.
+ *
+ * A is row-major and only its lower triangle is read. A tiny ridge keeps the
+ * factorization going when few paths are in the money and A is near singular.
+ * Returns false (and beta = 0) if A is not positive definite even then.
+ */
+bool solve_normal_equations(double* A, const double* b, int n, double* beta) {
+    double trace = 0.0;
+    for (int i = 0; i < n; ++i) {
+        trace += A[i * n + i];
+    }
+    const double ridge = 1e-12 * trace / n;
+    for (int i = 0; i < n; ++i) {
+        A[i * n + i] += ridge;
+    }
+
+    // A = L L^T, with L overwriting the lower triangle
+    for (int j = 0; j < n; ++j) {
+        double diagonal = A[j * n + j];
+        for (int k = 0; k < j; ++k) {
+            diagonal -= A[j * n + k] * A[j * n + k];
+        }
+        if (!(diagonal > 0.0)) {
+            std::fill(beta, beta + n, 0.0);
+            return false;
+        }
+        const double pivot = std::sqrt(diagonal);
+        A[j * n + j] = pivot;
+        for (int i = j + 1; i < n; ++i) {
+            double value = A[i * n + j];
+            for (int k = 0; k < j; ++k) {
+                value -= A[i * n + k] * A[j * n + k];
+            }
+            A[i * n + j] = value / pivot;
+        }
+    }
+
+    // Forward substitution L y = b, then back substitution L^T beta = y
+    for (int i = 0; i < n; ++i) {
+        double value = b[i];
+        for (int k = 0; k < i; ++k) {
+            value -= A[i * n + k] * beta[k];
+        }
+        beta[i] = value / A[i * n + i];
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        double value = beta[i];
+        for (int k = i + 1; k < n; ++k) {
+            value -= A[k * n + i] * beta[k];
+        }
+        beta[i] = value / A[i * n + i];
+    }
+    return true;
+}
+
+// Normal equations of one regression, accumulated in one reduction slot
+struct NormalEquations {
+    double A[kMaxBasis * kMaxBasis];
+    double b[kMaxBasis];
+
+    void clear() {
+        std::fill(A, A + kMaxBasis * kMaxBasis, 0.0);
+        std::fill(b, b + kMaxBasis, 0.0);
+    }
+
+    void merge(const NormalEquations& other) {
+        for (int k = 0; k < kMaxBasis * kMaxBasis; ++k) {
+            A[k] += other.A[k];
+        }
+        for (int k = 0; k < kMaxBasis; ++k) {
+            b[k] += other.b[k];
+        }
+    }
+};
+
+template <class Real>
+AmericanOptionResult run_lsm(MonteCarloEngine& engine, const GbmParameters& params, OptionType type, double strike,
+                             std::size_t num_paths, const LsmConfig& config) {
+    AmericanOptionResult result;
+    if (num_paths == 0) {
+        return result;
+    }
+    const int steps = std::max(params.steps, 1);
+    const std::size_t dates = static_cast<std::size_t>(std::min(std::max(config.exercise_dates, 1), steps));
+    const int num_basis = std::min(std::max(config.basis_degree, 0), kMaxBasis - 1) + 1;
+    const double dt = params.T / steps;
+
+    // Exercise date i is step round((i + 1) * steps / dates)
+    std::vector<std::size_t> exercise_steps(dates);
+    std::vector<int> date_of_step(static_cast<std::size_t>(steps) + 1, -1);
+    for (std::size_t i = 0; i < dates; ++i) {
+        exercise_steps[i] = static_cast<std::size_t>(
+            std::llround(static_cast<double>((i + 1) * steps) / static_cast<double>(dates)));
+        date_of_step[exercise_steps[i]] = static_cast<int>(i);
+    }
+
+    // Time-major blocks: price of path p at date i is
+    // paths[(block * dates + i) * kStorageBlock + offset], with p = block * kStorageBlock + offset
+    const std::size_t num_blocks = (num_paths + kStorageBlock - 1) / kStorageBlock;
+    std::vector<Real> paths(num_blocks * dates * kStorageBlock);
+    std::vector<double> cash(num_paths);       // Cash flow of each path, discounted to time 0
+    std::vector<double> weights(num_paths);
+    result.storage_bytes = paths.size() * sizeof(Real);
+
+    auto observer = [&](std::size_t first_path, std::size_t step, const double* prices, std::size_t count,
+                        unsigned) {
+        const std::size_t date = static_cast<std::size_t>(date_of_step[step]);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t p = first_path + i;
+            const std::size_t block = p / kStorageBlock;
+            paths[(block * dates + date) * kStorageBlock + p % kStorageBlock] = static_cast<Real>(prices[i]);
+        }
+    };
+    auto consumer = [&](std::size_t first_path, const double* prices, const double* path_weights,
+                        std::size_t count, unsigned) {
+        // Hold to expiry unless an earlier date says otherwise
+        const double discount = std::exp(-params.mu * params.T);
+        for (std::size_t i = 0; i < count; ++i) {
+            cash[first_path + i] = discount * exercise_value(type, prices[i], strike);
+            weights[first_path + i] = path_weights[i];
+        }
+    };
+    engine.for_each_observed_block(params, num_paths, exercise_steps, observer, consumer);
+
+    RunningStats european;
+    for (std::size_t p = 0; p < num_paths; ++p) {
+        european.add(weights[p] * cash[p]);
+    }
+
+    // Backward induction over the dates before expiry
+    ThreadPool& pool = engine.thread_pool();
+    std::vector<NormalEquations> slots(engine.reduction_slots(num_paths, kStorageBlock));
+    for (std::size_t date = dates - 1; date-- > 0;) {
+        const double t = static_cast<double>(exercise_steps[date]) * dt;
+        const double growth = std::exp(params.mu * t);  // Time-0 money to time-t money
+        const double inv_strike = 1.0 / strike;
+
+        // Regress the time-t value of the cash flows of in-the-money paths on the basis
+        for (NormalEquations& equations : slots) {
+            equations.clear();
+        }
+        pool.parallel_for(num_blocks, [&](std::size_t block, unsigned worker) {
+            const Real* row = &paths[(block * dates + date) * kStorageBlock];
+            const std::size_t begin = block * kStorageBlock;
+            NormalEquations& equations = slots[engine.reduction_slot(begin, worker, kStorageBlock)];
+            const std::size_t count = std::min(kStorageBlock, num_paths - begin);
+            double phi[kMaxBasis];
+            for (std::size_t i = 0; i < count; ++i) {
+                const double price = static_cast<double>(row[i]);
+                if (exercise_value(type, price, strike) <= 0.0) {
+                    continue;
+                }
+                polynomial_basis(price * inv_strike, num_basis, phi);
+                const double y = cash[begin + i] * growth;
+                for (int r = 0; r < num_basis; ++r) {
+                    for (int c = 0; c <= r; ++c) {
+                        equations.A[r * num_basis + c] += phi[r] * phi[c];
+                    }
+                    equations.b[r] += phi[r] * y;
+                }
+            }
+        });
+
+        NormalEquations total = merge_pairwise(slots);
+        double beta[kMaxBasis];
+        if (!solve_normal_equations(total.A, total.b, num_basis, beta)) {
+            continue;   // Too few paths in the money to fit: nobody exercises here
+        }
+
+        // Exercise wherever the exercise value beats the fitted continuation value
+        const double discount = 1.0 / growth;
+        pool.parallel_for(num_blocks, [&](std::size_t block, unsigned) {
+            const Real* row = &paths[(block * dates + date) * kStorageBlock];
+            const std::size_t begin = block * kStorageBlock;
+            const std::size_t count = std::min(kStorageBlock, num_paths - begin);
+            double phi[kMaxBasis];
+            for (std::size_t i = 0; i < count; ++i) {
+                const double price = static_cast<double>(row[i]);
+                const double exercise = exercise_value(type, price, strike);
+                if (exercise <= 0.0) {
+                    continue;
+                }
+                polynomial_basis(price * inv_strike, num_basis, phi);
+                double continuation = 0.0;
+                for (int k = 0; k < num_basis; ++k) {
+                    continuation += beta[k] * phi[k];
+                }
+                if (exercise > continuation) {
+                    cash[begin + i] = exercise * discount;
+                }
+            }
+        });
+    }
+
+    RunningStats american;
+    for (std::size_t p = 0; p < num_paths; ++p) {
+        american.add(weights[p] * cash[p]);
+    }
+
+    // Exercising right away is worth the intrinsic value
+    const double intrinsic = exercise_value(type, params.S0, strike);
+    result.price.num_paths = num_paths;
+    if (intrinsic > american.mean()) {
+        result.price.value = intrinsic;
+    } else {
+        result.price.value = american.mean();
+        result.price.std_error = american.std_error();
+    }
+    result.early_exercise_premium = result.price.value - european.mean();
+    return result;
+}
+
+} // namespace
+
+AmericanOptionResult price_american_option(MonteCarloEngine& engine, const GbmParameters& params, OptionType type,
+                                           double strike, std::size_t num_paths, const LsmConfig& config) {
+    if (config.single_precision) {
+        return run_lsm<float>(engine, params, type, strike, num_paths, config);
+    }
+    return run_lsm<double>(engine, params, type, strike, num_paths, config);
+}
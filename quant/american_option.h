@@ -0,0 +1,43 @@
+#ifndef AMERICAN_OPTION_H
+#define AMERICAN_OPTION_H
+
+#include <cstddef>
+
+#include "european_option.h"
+#include "monte_carlo_engine.h"
+
+// Settings of the Longstaff-Schwartz regression
+struct LsmConfig {
+    int exercise_dates = 50;        // Equally spaced in (0, T]; the last one is expiry
+    int basis_degree = 3;           // Continuation value is a polynomial of this degree in S / K (at most 7)
+    bool single_precision = false;  // Store the simulated prices as float to halve the memory
+};
+
+struct AmericanOptionResult {
+    Estimate price;
+    double early_exercise_premium = 0.0;    // Over the European price on the same paths
+    std::size_t storage_bytes = 0;          // Memory held by the stored paths
+};
+
+/**
+ * @brief Prices an American (Bermudan) option by Longstaff-Schwartz regression.
+ *
+ * params.mu is the risk-free rate. Paths are simulated once and stored only at
+ * the exercise dates, in blocks of paths laid out time-major (all of a block's
+ * prices for one date are contiguous), so the backward sweep streams one short
+ * row per block and date. At each date, working backwards, the discounted
+ * cash flows of in-the-money paths are regressed on the basis; the normal
+ * equations are accumulated in parallel over path blocks and solved by a
+ * small fixed-size Cholesky factorization. Paths whose exercise value beats
+ * the fitted continuation value exercise there.
+ *
+ * Memory is num_paths * exercise_dates values (4 bytes each in single
+ * precision) plus one cash flow per path; with exact_terminal on, only the
+ * exercise dates are simulated. The estimate is in-sample: the same paths
+ * fit the exercise rule and price it.
+ */
+AmericanOptionResult price_american_option(MonteCarloEngine& engine, const GbmParameters& params, OptionType type,
+                                           double strike, std::size_t num_paths,
+                                           const LsmConfig& config = LsmConfig());
+
+#endif // AMERICAN_OPTION_H
@@ -0,0 +1,221 @@
+#include "basket.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "normal_math.h"
+#include "process_simulator.h"
+#include "streaming_stats.h"
+
+namespace {
+
+// Paths per GEMM tile: N rows of normals and of results stay in L2 for N in the hundreds
+const std::size_t kLaneTile = 128;
+
+// Rows of W computed together, so each row of Z is loaded once per group
+const std::size_t kRowBlock = 4;
+
+std::vector<double> equal_weights(std::size_t n, const std::vector<double>& weights) {
+    return weights.empty() ? std::vector<double>(n, 1.0 / static_cast<double>(n)) : weights;
+}
+
+} // namespace
+
+BasketProcess::BasketProcess(const BasketParameters& params, SimdIsa isa)
+    : params(params), kernel(select_gbm_step_kernel(isa)) {
+    const std::size_t n = params.S0.size();
+    if (params.sigma.size() != n || params.correlation.size() != n * n) {
+        throw std::invalid_argument("BasketProcess: S0, sigma and correlation sizes do not match");
+    }
+
+    // C = L L^T; a zero pivot (perfectly correlated assets) gives a zero column
+    lower.assign(n * n, 0.0);
+    for (std::size_t j = 0; j < n; ++j) {
+        double diagonal = params.correlation[j * n + j];
+        for (std::size_t k = 0; k < j; ++k) {
+            diagonal -= lower[j * n + k] * lower[j * n + k];
+        }
+        if (diagonal < -1e-10) {
+            throw std::invalid_argument("BasketProcess: correlation matrix is not positive semi-definite");
+        }
+        const double pivot = std::sqrt(std::max(diagonal, 0.0));
+        lower[j * n + j] = pivot;
+        for (std::size_t i = j + 1; i < n; ++i) {
+            double value = params.correlation[i * n + j];
+            for (std::size_t k = 0; k < j; ++k) {
+                value -= lower[i * n + k] * lower[j * n + k];
+            }
+            lower[i * n + j] = (pivot > 1e-12) ? value / pivot : 0.0;
+        }
+    }
+}
+
+std::size_t BasketProcess::num_assets() const {
+    return params.S0.size();
+}
+
+const std::vector<double>& BasketProcess::cholesky_factor() const {
+    return lower;
+}
+
+void BasketProcess::initialize(double* state, std::size_t count) const {
+    for (std::size_t i = 0; i < num_assets(); ++i) {
+        std::fill(state + i * count, state + (i + 1) * count, params.S0[i]);
+    }
+}
+
+void BasketProcess::step(double* state, const double* const* z, std::size_t count, double dt) const {
+    const std::size_t n = num_assets();
+    const double sqrt_dt = std::sqrt(dt);
+
+    // Scratch for one tile of correlated normals, w[i * kLaneTile + p]
+    static thread_local std::vector<double> correlated;
+    correlated.resize(n * kLaneTile);
+
+    for (std::size_t tile = 0; tile < count; tile += kLaneTile) {
+        const std::size_t width = std::min(kLaneTile, count - tile);
+
+        // W = L Z for this tile, kRowBlock rows at a time. L is lower triangular,
+        // so rows i..i+3 only need Z rows 0..i+3.
+        for (std::size_t i = 0; i < n; i += kRowBlock) {
+            const std::size_t rows = std::min(kRowBlock, n - i);
+            double* w[kRowBlock];
+            double l[kRowBlock];
+            for (std::size_t r = 0; r < kRowBlock; ++r) {
+                w[r] = correlated.data() + std::min(i + r, n - 1) * kLaneTile;
+            }
+            for (std::size_t r = 0; r < rows; ++r) {
+                std::fill(w[r], w[r] + width, 0.0);
+            }
+            const std::size_t last = std::min(i + rows, n);
+            for (std::size_t j = 0; j < last; ++j) {
+                const double* zj = z[j] + tile;
+                for (std::size_t r = 0; r < kRowBlock; ++r) {
+                    l[r] = (r < rows) ? lower[(i + r) * n + j] : 0.0;
+                }
+                if (rows == kRowBlock) {
+                    double* w0 = w[0];
+                    double* w1 = w[1];
+                    double* w2 = w[2];
+                    double* w3 = w[3];
+                    for (std::size_t p = 0; p < width; ++p) {
+                        const double value = zj[p];
+                        w0[p] += l[0] * value;
+                        w1[p] += l[1] * value;
+                        w2[p] += l[2] * value;
+                        w3[p] += l[3] * value;
+                    }
+                } else {
+                    for (std::size_t r = 0; r < rows; ++r) {
+                        for (std::size_t p = 0; p < width; ++p) {
+                            w[r][p] += l[r] * zj[p];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Advance every asset of the tile with its own drift and volatility
+        for (std::size_t a = 0; a < n; ++a) {
+            const double sigma = params.sigma[a];
+            kernel(state + a * count + tile, correlated.data() + a * kLaneTile, width,
+                   (params.r - 0.5 * sigma * sigma) * dt, sigma * sqrt_dt);
+        }
+    }
+}
+
+Estimate price_basket_option(MonteCarloEngine& engine, const BasketParameters& params, BasketStyle style,
+                             OptionType type, double strike, double T, std::size_t num_paths, int steps,
+                             const std::vector<double>& weights) {
+    const BasketProcess process(params, engine.isa());
+    const std::size_t n = process.num_assets();
+    const std::vector<double> w = equal_weights(n, weights);
+    const double discount = std::exp(-params.r * T);
+
+    // Scratch per worker; the statistics go to the simulator's reduction slots
+    std::vector<std::vector<double>> scratch(engine.num_threads());
+    ProcessSimulator<BasketProcess> simulator(process, engine);
+    std::vector<RunningStats> slots(simulator.reduction_slots(num_paths));
+
+    simulator.for_each_block(T, steps, num_paths, [&](std::size_t first_path, const double* prices, const double*,
+                                                      std::size_t count, unsigned worker) {
+        // Reduce the assets lane-wise into one underlying value per path
+        std::vector<double>& underlying = scratch[worker];
+        switch (style) {
+        case BasketStyle::Arithmetic:
+            underlying.assign(count, 0.0);
+            for (std::size_t a = 0; a < n; ++a) {
+                for (std::size_t p = 0; p < count; ++p) {
+                    underlying[p] += w[a] * prices[a * count + p];
+                }
+            }
+            break;
+        case BasketStyle::Geometric:
+            underlying.assign(count, 0.0);
+            for (std::size_t a = 0; a < n; ++a) {
+                for (std::size_t p = 0; p < count; ++p) {
+                    underlying[p] += w[a] * std::log(prices[a * count + p]);
+                }
+            }
+            for (std::size_t p = 0; p < count; ++p) {
+                underlying[p] = std::exp(underlying[p]);
+            }
+            break;
+        case BasketStyle::BestOf:
+            underlying.assign(prices, prices + count);
+            for (std::size_t a = 1; a < n; ++a) {
+                for (std::size_t p = 0; p < count; ++p) {
+                    underlying[p] = std::max(underlying[p], prices[a * count + p]);
+                }
+            }
+            break;
+        case BasketStyle::WorstOf:
+            underlying.assign(prices, prices + count);
+            for (std::size_t a = 1; a < n; ++a) {
+                for (std::size_t p = 0; p < count; ++p) {
+                    underlying[p] = std::min(underlying[p], prices[a * count + p]);
+                }
+            }
+            break;
+        }
+
+        RunningStats& stats = slots[simulator.reduction_slot(first_path, worker)];
+        for (std::size_t p = 0; p < count; ++p) {
+            const double payoff = (type == OptionType::Call) ? std::max(underlying[p] - strike, 0.0)
+                                                             : std::max(strike - underlying[p], 0.0);
+            stats.add(discount * payoff);
+        }
+    });
+
+    const RunningStats total = merge_pairwise(slots);
+    Estimate estimate;
+    estimate.value = total.mean();
+    estimate.std_error = total.std_error();
+    estimate.num_paths = static_cast<std::size_t>(total.count());
+    return estimate;
+}
+
+double geometric_basket_price(const BasketParameters& params, OptionType type, double strike, double T,
+                              const std::vector<double>& weights) {
+    const std::size_t n = params.S0.size();
+    const std::vector<double> w = equal_weights(n, weights);
+
+    // log G = sum w_i log S_i(T) is normal
+    double mean = 0.0, variance = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        mean += w[i] * (std::log(params.S0[i]) + (params.r - 0.5 * params.sigma[i] * params.sigma[i]) * T);
+        for (std::size_t j = 0; j < n; ++j) {
+            variance += w[i] * w[j] * params.correlation[i * n + j] * params.sigma[i] * params.sigma[j] * T;
+        }
+    }
+    const double stdev = std::sqrt(variance);
+    const double forward = std::exp(mean + 0.5 * variance);
+    const double d1 = (std::log(forward / strike) + 0.5 * variance) / stdev;
+    const double d2 = d1 - stdev;
+    const double discount = std::exp(-params.r * T);
+    if (type == OptionType::Call) {
+        return discount * (forward * normal_cdf(d1) - strike * normal_cdf(d2));
+    }
+    return discount * (strike * normal_cdf(-d2) - forward * normal_cdf(-d1));
+}
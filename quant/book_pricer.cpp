@@ -0,0 +1,73 @@
+#include "book_pricer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "streaming_stats.h"
+
+std::vector<Estimate> price_book(MonteCarloEngine& engine, const std::vector<BookEntry>& book) {
+    const std::size_t block_size = engine.block_size();
+
+    // Each instrument is walked like price_path_dependent's run: every step observed
+    std::vector<MonteCarloEngine::BlockWalk> walks;
+    for (const BookEntry& entry : book) {
+        walks.push_back(engine.prepare_walk(entry.params, std::vector<std::size_t>()));
+    }
+
+    // Task t is block t - first_task[i] of instrument i
+    std::vector<std::size_t> first_task(book.size() + 1, 0);
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        first_task[i + 1] = first_task[i] + (book[i].num_paths + block_size - 1) / block_size;
+    }
+    std::vector<RunningStats> task_stats(first_task.back());
+
+    // Each worker owns the payoff state of the chunk it is walking
+    struct WorkerState {
+        std::vector<double> state;
+        std::vector<double> payoffs;
+    };
+    std::vector<WorkerState> workers(engine.num_threads());
+
+    engine.thread_pool().parallel_for(task_stats.size(), [&](std::size_t task, unsigned worker) {
+        const std::size_t i = static_cast<std::size_t>(
+            std::upper_bound(first_task.begin(), first_task.end(), task) - first_task.begin()) - 1;
+        const BookEntry& entry = book[i];
+        const PathPayoff& payoff = *entry.payoff;
+        const double S0 = entry.params.S0;
+        const double discount = std::exp(-entry.params.mu * entry.params.T);
+        const std::size_t begin = (task - first_task[i]) * block_size;
+        RunningStats& stats = task_stats[task];
+        WorkerState& local = workers[worker];
+
+        const MonteCarloEngine::StepObserver observer = [&](std::size_t, std::size_t step, const double* prices,
+                                                            std::size_t count, unsigned) {
+            if (step == 1) {
+                // First step of a new chunk
+                local.state.resize(payoff.state_size() * count);
+                payoff.initialize(local.state.data(), count, S0);
+            }
+            payoff.update(local.state.data(), prices, count, step);
+        };
+        const MonteCarloEngine::BlockConsumer consumer = [&](std::size_t, const double* prices,
+                                                             const double* weights, std::size_t count, unsigned) {
+            local.payoffs.resize(count);
+            payoff.payoff(local.state.data(), prices, count, local.payoffs.data());
+            for (std::size_t p = 0; p < count; ++p) {
+                stats.add(discount * weights[p] * local.payoffs[p]);
+            }
+        };
+        engine.walk_block(walks[i], begin, std::min(block_size, entry.num_paths - begin), &observer, consumer,
+                          worker);
+    });
+
+    // Merge each instrument's blocks in a fixed pairwise tree, whatever the schedule was
+    std::vector<Estimate> estimates(book.size());
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        std::vector<RunningStats> blocks(task_stats.begin() + first_task[i], task_stats.begin() + first_task[i + 1]);
+        const RunningStats total = merge_pairwise(blocks);
+        estimates[i].value = total.mean();
+        estimates[i].std_error = total.std_error();
+        estimates[i].num_paths = static_cast<std::size_t>(total.count());
+    }
+    return estimates;
+}
@@ -0,0 +1,34 @@
+#ifndef BOOK_PRICER_H
+#define BOOK_PRICER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "european_option.h"
+#include "monte_carlo_engine.h"
+#include "path_payoffs.h"
+
+// One instrument of a book: its own model, grid, payoff and path count
+struct BookEntry {
+    GbmParameters params;               // mu is the risk-free rate; steps is the monitoring grid
+    const PathPayoff* payoff = nullptr;
+    std::size_t num_paths = 0;
+};
+
+/**
+ * @brief Prices a heterogeneous book in one parallel pass.
+ *
+ * Every instrument is cut into path blocks of engine.block_size() paths, and
+ * all blocks of all instruments go to the pool's work-stealing scheduler as
+ * one set of tasks, so a 252-step exotic and a one-step vanilla share the
+ * workers without one waiting on the other. Each block is simulated by
+ * engine.walk_block(), so sampling mode, antithetic pairs and importance
+ * weights apply exactly as in price_path_dependent. Each task keeps its own
+ * statistics, merged per instrument by merge_pairwise() over block order, so
+ * prices do not depend on the number of threads or on who stole what, and
+ * match price_path_dependent on a reproducible engine bit for bit.
+ * Scheduler counters are left in engine.thread_pool().stats().
+ */
+std::vector<Estimate> price_book(MonteCarloEngine& engine, const std::vector<BookEntry>& book);
+
+#endif // BOOK_PRICER_H
@@ -0,0 +1,92 @@
+#include "brownian_bridge.h"
+
+#include <cmath>
+
+namespace {
+
+std::vector<double> equally_spaced(std::size_t steps) {
+    std::vector<double> times(steps);
+    for (std::size_t i = 0; i < steps; ++i) {
+        times[i] = static_cast<double>(i + 1);
+    }
+    return times;
+}
+
+} // namespace
+
+BrownianBridge::BrownianBridge(std::size_t steps) : BrownianBridge(equally_spaced(steps)) {}
+
+BrownianBridge::BrownianBridge(const std::vector<double>& times)
+    : num_steps(times.size()), left_index(num_steps), right_index(num_steps), bridge_index(num_steps),
+      left_weight(num_steps), right_weight(num_steps), std_dev(num_steps), inv_sqrt_dt(num_steps) {
+    if (num_steps == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < num_steps; ++i) {
+        inv_sqrt_dt[i] = 1.0 / std::sqrt(times[i] - ((i > 0) ? times[i - 1] : 0.0));
+    }
+
+    // Point i of the path sits at time times[i].
+    // filled[i] is true once point i has been placed.
+    std::vector<bool> filled(num_steps, false);
+    bridge_index[0] = num_steps - 1;
+    std_dev[0] = std::sqrt(times[num_steps - 1]);
+    filled[num_steps - 1] = true;
+
+    std::size_t j = 0;
+    for (std::size_t i = 1; i < num_steps; ++i) {
+        // Find the next gap [j, k) of unfilled points; point k bounds it on the right
+        while (filled[j]) {
+            ++j;
+        }
+        std::size_t k = j;
+        while (!filled[k]) {
+            ++k;
+        }
+        std::size_t l = j + ((k - 1 - j) >> 1);
+        filled[l] = true;
+
+        // The left neighbour is point j - 1, or the origin (t = 0, W = 0) when j == 0
+        const double t_left = (j > 0) ? times[j - 1] : 0.0;
+        const double t_mid = times[l];
+        const double t_right = times[k];
+        bridge_index[i] = l;
+        left_index[i] = j;
+        right_index[i] = k;
+        left_weight[i] = (t_right - t_mid) / (t_right - t_left);
+        right_weight[i] = (t_mid - t_left) / (t_right - t_left);
+        std_dev[i] = std::sqrt((t_mid - t_left) * (t_right - t_mid) / (t_right - t_left));
+
+        j = k + 1;
+        if (j >= num_steps) {
+            j = 0;
+        }
+    }
+}
+
+std::size_t BrownianBridge::steps() const {
+    return num_steps;
+}
+
+void BrownianBridge::build_increments(const double* z, double* increments) const {
+    if (num_steps == 0) {
+        return;
+    }
+
+    // Build the path W(t_i) in place, coarsest points first
+    double* path = increments;
+    path[num_steps - 1] = std_dev[0] * z[0];
+    for (std::size_t i = 1; i < num_steps; ++i) {
+        const std::size_t j = left_index[i];
+        const std::size_t k = right_index[i];
+        const std::size_t l = bridge_index[i];
+        const double left_value = (j > 0) ? path[j - 1] : 0.0;
+        path[l] = left_weight[i] * left_value + right_weight[i] * path[k] + std_dev[i] * z[i];
+    }
+
+    // Difference the path into increments and scale each to unit variance
+    for (std::size_t i = num_steps - 1; i > 0; --i) {
+        path[i] = (path[i] - path[i - 1]) * inv_sqrt_dt[i];
+    }
+    path[0] *= inv_sqrt_dt[0];
+}
@@ -0,0 +1,41 @@
+#ifndef BROWNIAN_BRIDGE_H
+#define BROWNIAN_BRIDGE_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Brownian-bridge construction of a discretely sampled Brownian path.
+ *
+ * The first normal fixes the terminal value, the next one the midpoint, and so
+ * on by bisection. With quasi-random inputs this puts most of the path's
+ * variance into the first (best distributed) Sobol dimensions.
+ * Output increments are scaled to unit variance, so they are i.i.d. N(0, 1)
+ * and can go straight into the step kernel in place of ordinary normals,
+ * whether or not the time points are equally spaced.
+ */
+class BrownianBridge {
+public:
+    // Equally spaced time points 1, 2, ..., steps
+    explicit BrownianBridge(std::size_t steps);
+
+    // Arbitrary increasing time points (all > 0); the path starts at W(0) = 0
+    explicit BrownianBridge(const std::vector<double>& times);
+
+    std::size_t steps() const;
+
+    // Turns steps() independent normals into steps() unit-variance Brownian increments
+    void build_increments(const double* z, double* increments) const;
+
+private:
+    std::size_t num_steps;
+    std::vector<std::size_t> left_index;
+    std::vector<std::size_t> right_index;
+    std::vector<std::size_t> bridge_index;
+    std::vector<double> left_weight;
+    std::vector<double> right_weight;
+    std::vector<double> std_dev;
+    std::vector<double> inv_sqrt_dt;   // Scales each increment to unit variance
+};
+
+#endif // BROWNIAN_BRIDGE_H
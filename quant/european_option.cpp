@@ -0,0 +1,123 @@
+#include "european_option.h"
+
+#include <cmath>
+#include <vector>
+
+#include "normal_math.h"
+#include "streaming_stats.h"
+
+namespace {
+
+const int kQuantities = 5;
+
+// Accumulators of the price, delta, gamma, vega and rho
+struct GreekSums {
+    RunningStats stats[kQuantities];
+
+    void merge(const GreekSums& other) {
+        for (int q = 0; q < kQuantities; ++q) {
+            stats[q].merge(other.stats[q]);
+        }
+    }
+};
+
+} // namespace
+
+OptionGreeks black_scholes(OptionType type, double S0, double strike, double rate, double sigma, double T) {
+    const double sqrt_T = std::sqrt(T);
+    const double d1 = (std::log(S0 / strike) + (rate + 0.5 * sigma * sigma) * T) / (sigma * sqrt_T);
+    const double d2 = d1 - sigma * sqrt_T;
+    const double discount = std::exp(-rate * T);
+
+    OptionGreeks greeks;
+    greeks.gamma = normal_pdf(d1) / (S0 * sigma * sqrt_T);
+    greeks.vega = S0 * normal_pdf(d1) * sqrt_T;
+    if (type == OptionType::Call) {
+        greeks.price = S0 * normal_cdf(d1) - strike * discount * normal_cdf(d2);
+        greeks.delta = normal_cdf(d1);
+        greeks.rho = strike * T * discount * normal_cdf(d2);
+    } else {
+        greeks.price = strike * discount * normal_cdf(-d2) - S0 * normal_cdf(-d1);
+        greeks.delta = normal_cdf(d1) - 1.0;
+        greeks.rho = -strike * T * discount * normal_cdf(-d2);
+    }
+    return greeks;
+}
+
+EuropeanOptionResult price_european_option(MonteCarloEngine& engine, const GbmParameters& params,
+                                           OptionType type, double strike, std::size_t num_paths,
+                                           GreekEstimator estimator) {
+    const double S0 = params.S0;
+    const double r = params.mu;
+    const double sigma = params.sigma;
+    const double T = params.T;
+    const double sqrt_T = std::sqrt(T);
+    const double discount = std::exp(-r * T);
+    const double log_drift = (r - 0.5 * sigma * sigma) * T;
+
+    // One set of accumulators per reduction slot
+    std::vector<GreekSums> slots(engine.reduction_slots(num_paths));
+
+    engine.for_each_block(params, num_paths, [&](std::size_t first_path, const double* prices,
+                                                  const double* weights, std::size_t count, unsigned worker) {
+        RunningStats* stats = slots[engine.reduction_slot(first_path, worker)].stats;
+        for (std::size_t i = 0; i < count; ++i) {
+            const double S_T = prices[i];
+            const double w = weights[i] * discount;
+
+            // Payoff f and its derivative f' with respect to S_T
+            double payoff, slope;
+            if (type == OptionType::Call) {
+                payoff = (S_T > strike) ? S_T - strike : 0.0;
+                slope = (S_T > strike) ? 1.0 : 0.0;
+            } else {
+                payoff = (S_T < strike) ? strike - S_T : 0.0;
+                slope = (S_T < strike) ? -1.0 : 0.0;
+            }
+
+            // The standard normal behind this S_T
+            const double Z = (std::log(S_T / S0) - log_drift) / (sigma * sqrt_T);
+
+            double delta, gamma, vega, rho;
+            if (estimator == GreekEstimator::Pathwise) {
+                // dS_T/dS0 = S_T / S0, dS_T/dsigma = S_T (sqrt(T) Z - sigma T), dS_T/dr = T S_T.
+                // f' has a jump, so gamma differentiates the pathwise delta by likelihood ratio.
+                delta = slope * S_T / S0;
+                gamma = slope * S_T / (S0 * S0) * (Z / (sigma * sqrt_T) - 1.0);
+                vega = slope * S_T * (sqrt_T * Z - sigma * T);
+                rho = T * (slope * S_T - payoff);
+            } else {
+                // Scores: derivatives of the log-density of S_T with respect to each input
+                delta = payoff * Z / (S0 * sigma * sqrt_T);
+                gamma = payoff * ((Z * Z - 1.0) / (S0 * S0 * sigma * sigma * T) - Z / (S0 * S0 * sigma * sqrt_T));
+                vega = payoff * ((Z * Z - 1.0) / sigma - Z * sqrt_T);
+                rho = payoff * (Z * sqrt_T / sigma - T);
+            }
+
+            stats[0].add(w * payoff);
+            stats[1].add(w * delta);
+            stats[2].add(w * gamma);
+            stats[3].add(w * vega);
+            stats[4].add(w * rho);
+        }
+    });
+
+    const GreekSums total = merge_pairwise(slots);
+    const RunningStats* totals = total.stats;
+
+    auto to_estimate = [](const RunningStats& stats) {
+        Estimate estimate;
+        estimate.value = stats.mean();
+        estimate.std_error = stats.std_error();
+        estimate.num_paths = static_cast<std::size_t>(stats.count());
+        return estimate;
+    };
+
+    EuropeanOptionResult result;
+    result.price = to_estimate(totals[0]);
+    result.delta = to_estimate(totals[1]);
+    result.gamma = to_estimate(totals[2]);
+    result.vega = to_estimate(totals[3]);
+    result.rho = to_estimate(totals[4]);
+    return result;
+}
@@ -0,0 +1,53 @@
+#ifndef EUROPEAN_OPTION_H
+#define EUROPEAN_OPTION_H
+
+#include <cstddef>
+
+#include "monte_carlo_engine.h"
+
+enum class OptionType {
+    Call,
+    Put
+};
+
+// How the Monte Carlo sensitivities are estimated from the simulated paths
+enum class GreekEstimator {
+    Pathwise,           // Differentiates each path's payoff; gamma uses the mixed LR-pathwise form
+    LikelihoodRatio     // Differentiates the density of S_T; needs no payoff derivative
+};
+
+// Closed-form price and sensitivities
+struct OptionGreeks {
+    double price = 0.0;
+    double delta = 0.0;
+    double gamma = 0.0;
+    double vega = 0.0;
+    double rho = 0.0;
+};
+
+// Monte Carlo price and sensitivities, each with its standard error
+struct EuropeanOptionResult {
+    Estimate price;
+    Estimate delta;
+    Estimate gamma;
+    Estimate vega;
+    Estimate rho;
+};
+
+// Black-Scholes price and Greeks of a European option
+OptionGreeks black_scholes(OptionType type, double S0, double strike, double rate, double sigma, double T);
+
+/**
+ * @brief Prices a European call or put and its Greeks from a single simulation.
+ *
+ * params.mu is taken as the risk-free rate (risk-neutral drift). Delta, gamma,
+ * vega and rho come from the same paths as the price, so no bump-and-revalue
+ * runs are needed. Each path's standard normal is recovered from S_T, which
+ * works for both exact terminal sampling and full stepping. Importance-sampling
+ * weights from the engine are applied to every estimator.
+ */
+EuropeanOptionResult price_european_option(MonteCarloEngine& engine, const GbmParameters& params,
+                                           OptionType type, double strike, std::size_t num_paths,
+                                           GreekEstimator estimator = GreekEstimator::Pathwise);
+
+#endif // EUROPEAN_OPTION_H
@@ -0,0 +1,84 @@
+#include "gbm_kernel.h"
+
+#include <cmath>
+
+const char* simd_isa_name(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::Avx2:
+            return "avx2";
+        case SimdIsa::Avx512:
+            return "avx512";
+        case SimdIsa::Scalar:
+        default:
+            return "scalar";
+    }
+}
+
+bool simd_isa_supported(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::Scalar:
+            return true;
+#if defined(QUANT_HAVE_X86_KERNELS) && (defined(__GNUC__) || defined(__clang__))
+        case SimdIsa::Avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case SimdIsa::Avx512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+SimdIsa detect_simd_isa() {
+    if (simd_isa_supported(SimdIsa::Avx512)) {
+        return SimdIsa::Avx512;
+    }
+    if (simd_isa_supported(SimdIsa::Avx2)) {
+        return SimdIsa::Avx2;
+    }
+    return SimdIsa::Scalar;
+}
+
+GbmStepKernel select_gbm_step_kernel(SimdIsa isa) {
+    if (!simd_isa_supported(isa)) {
+        return gbm_step_scalar;
+    }
+    switch (isa) {
+#if defined(QUANT_HAVE_X86_KERNELS)
+        case SimdIsa::Avx2:
+            return gbm_step_avx2;
+        case SimdIsa::Avx512:
+            return gbm_step_avx512;
+#endif
+        default:
+            return gbm_step_scalar;
+    }
+}
+
+GbmStepKernelF32 select_gbm_step_kernel_f32(SimdIsa isa) {
+    if (!simd_isa_supported(isa)) {
+        return gbm_step_scalar_f32;
+    }
+    switch (isa) {
+#if defined(QUANT_HAVE_X86_KERNELS)
+        case SimdIsa::Avx2:
+            return gbm_step_avx2_f32;
+        case SimdIsa::Avx512:
+            return gbm_step_avx512_f32;
+#endif
+        default:
+            return gbm_step_scalar_f32;
+    }
+}
+
+void gbm_step_scalar(double* prices, const double* z, std::size_t n, double drift_dt, double vol_sqrt_dt) {
+    for (std::size_t i = 0; i < n; ++i) {
+        prices[i] *= std::exp(drift_dt + vol_sqrt_dt * z[i]);
+    }
+}
+
+void gbm_step_scalar_f32(float* prices, const float* z, std::size_t n, float drift_dt, float vol_sqrt_dt) {
+    for (std::size_t i = 0; i < n; ++i) {
+        prices[i] *= std::exp(drift_dt + vol_sqrt_dt * z[i]);
+    }
+}
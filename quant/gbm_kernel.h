@@ -0,0 +1,48 @@
+#ifndef GBM_KERNEL_H
+#define GBM_KERNEL_H
+
+#include <cstddef>
+
+// Instruction sets the batched GBM kernel is compiled for
+enum class SimdIsa {
+    Scalar,     // Plain C++ loop, always available
+    Avx2,       // 4 double lanes (AVX2 + FMA)
+    Avx512      // 8 double lanes (AVX-512F)
+};
+
+/**
+ * @brief Advances a batch of paths by one GBM step.
+ *
+ * Computes prices[i] *= exp(drift_dt + vol_sqrt_dt * z[i]) for i in [0, n).
+ * The constants are hoisted by the caller:
+ *   drift_dt    = (mu - 0.5 * sigma^2) * dt
+ *   vol_sqrt_dt = sigma * sqrt(dt)
+ */
+using GbmStepKernel = void (*)(double* prices, const double* z, std::size_t n,
+                               double drift_dt, double vol_sqrt_dt);
+
+// The same step in single precision: twice the lanes per vector, half the bytes per path
+using GbmStepKernelF32 = void (*)(float* prices, const float* z, std::size_t n, float drift_dt, float vol_sqrt_dt);
+
+// Human-readable name of an instruction set ("scalar", "avx2", "avx512")
+const char* simd_isa_name(SimdIsa isa);
+
+// True if this binary contains the kernel and the running CPU can execute it
+bool simd_isa_supported(SimdIsa isa);
+
+// Widest instruction set supported by the running CPU
+SimdIsa detect_simd_isa();
+
+// Returns the kernel for isa, or the scalar kernel if isa is not supported
+GbmStepKernel select_gbm_step_kernel(SimdIsa isa);
+GbmStepKernelF32 select_gbm_step_kernel_f32(SimdIsa isa);
+
+void gbm_step_scalar(double* prices, const double* z, std::size_t n, double drift_dt, double vol_sqrt_dt);
+void gbm_step_avx2(double* prices, const double* z, std::size_t n, double drift_dt, double vol_sqrt_dt);
+void gbm_step_avx512(double* prices, const double* z, std::size_t n, double drift_dt, double vol_sqrt_dt);
+
+void gbm_step_scalar_f32(float* prices, const float* z, std::size_t n, float drift_dt, float vol_sqrt_dt);
+void gbm_step_avx2_f32(float* prices, const float* z, std::size_t n, float drift_dt, float vol_sqrt_dt);
+void gbm_step_avx512_f32(float* prices, const float* z, std::size_t n, float drift_dt, float vol_sqrt_dt);
+
+#endif // GBM_KERNEL_H
@@ -0,0 +1,58 @@
+// Compiled with -mavx2 -mfma; only called after a runtime CPU check.
+#include "gbm_kernel.h"
+#include "simd_math.h"
+
+void gbm_step_avx2(double* prices, const double* z, std::size_t n, double drift_dt, double vol_sqrt_dt) {
+    const __m256d drift = _mm256_set1_pd(drift_dt);
+    const __m256d vol = _mm256_set1_pd(vol_sqrt_dt);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d zi = _mm256_loadu_pd(z + i);
+        __m256d growth = simd_math::exp_pd(_mm256_fmadd_pd(vol, zi, drift));
+        _mm256_storeu_pd(prices + i, _mm256_mul_pd(_mm256_loadu_pd(prices + i), growth));
+    }
+
+    // Finish the remainder with the same vector exp so every lane sees identical math
+    if (i < n) {
+        alignas(32) double price_tail[4] = {1.0, 1.0, 1.0, 1.0};
+        alignas(32) double z_tail[4] = {0.0, 0.0, 0.0, 0.0};
+        const std::size_t remaining = n - i;
+        for (std::size_t k = 0; k < remaining; ++k) {
+            price_tail[k] = prices[i + k];
+            z_tail[k] = z[i + k];
+        }
+        __m256d growth = simd_math::exp_pd(_mm256_fmadd_pd(vol, _mm256_load_pd(z_tail), drift));
+        _mm256_store_pd(price_tail, _mm256_mul_pd(_mm256_load_pd(price_tail), growth));
+        for (std::size_t k = 0; k < remaining; ++k) {
+            prices[i + k] = price_tail[k];
+        }
+    }
+}
+
+void gbm_step_avx2_f32(float* prices, const float* z, std::size_t n, float drift_dt, float vol_sqrt_dt) {
+    const __m256 drift = _mm256_set1_ps(drift_dt);
+    const __m256 vol = _mm256_set1_ps(vol_sqrt_dt);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 zi = _mm256_loadu_ps(z + i);
+        __m256 growth = simd_math::exp_ps(_mm256_fmadd_ps(vol, zi, drift));
+        _mm256_storeu_ps(prices + i, _mm256_mul_ps(_mm256_loadu_ps(prices + i), growth));
+    }
+
+    if (i < n) {
+        alignas(32) float price_tail[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+        alignas(32) float z_tail[8] = {};
+        const std::size_t remaining = n - i;
+        for (std::size_t k = 0; k < remaining; ++k) {
+            price_tail[k] = prices[i + k];
+            z_tail[k] = z[i + k];
+        }
+        __m256 growth = simd_math::exp_ps(_mm256_fmadd_ps(vol, _mm256_load_ps(z_tail), drift));
+        _mm256_store_ps(price_tail, _mm256_mul_ps(_mm256_load_ps(price_tail), growth));
+        for (std::size_t k = 0; k < remaining; ++k) {
+            prices[i + k] = price_tail[k];
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// Compiled with -mavx512f; only called after a runtime CPU check.
+#include "gbm_kernel.h"
+#include "simd_math.h"
+
+void gbm_step_avx512(double* prices, const double* z, std::size_t n, double drift_dt, double vol_sqrt_dt) {
+    const __m512d drift = _mm512_set1_pd(drift_dt);
+    const __m512d vol = _mm512_set1_pd(vol_sqrt_dt);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d zi = _mm512_loadu_pd(z + i);
+        __m512d growth = simd_math::exp_pd(_mm512_fmadd_pd(vol, zi, drift));
+        _mm512_storeu_pd(prices + i, _mm512_mul_pd(_mm512_loadu_pd(prices + i), growth));
+    }
+
+    // Masked loads and stores handle the last partial vector
+    if (i < n) {
+        const __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        __m512d zi = _mm512_maskz_loadu_pd(mask, z + i);
+        __m512d growth = simd_math::exp_pd(_mm512_fmadd_pd(vol, zi, drift));
+        __m512d pi = _mm512_maskz_loadu_pd(mask, prices + i);
+        _mm512_mask_storeu_pd(prices + i, mask, _mm512_mul_pd(pi, growth));
+    }
+}
+
+void gbm_step_avx512_f32(float* prices, const float* z, std::size_t n, float drift_dt, float vol_sqrt_dt) {
+    const __m512 drift = _mm512_set1_ps(drift_dt);
+    const __m512 vol = _mm512_set1_ps(vol_sqrt_dt);
+
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 zi = _mm512_loadu_ps(z + i);
+        __m512 growth = simd_math::exp_ps(_mm512_fmadd_ps(vol, zi, drift));
+        _mm512_storeu_ps(prices + i, _mm512_mul_ps(_mm512_loadu_ps(prices + i), growth));
+    }
+
+    if (i < n) {
+        const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        __m512 zi = _mm512_maskz_loadu_ps(mask, z + i);
+        __m512 growth = simd_math::exp_ps(_mm512_fmadd_ps(vol, zi, drift));
+        __m512 pi = _mm512_maskz_loadu_ps(mask, prices + i);
+        _mm512_mask_storeu_ps(prices + i, mask, _mm512_mul_ps(pi, growth));
+    }
+}
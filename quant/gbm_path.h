@@ -0,0 +1,25 @@
+#ifndef GBM_PATH_H
+#define GBM_PATH_H
+
+#include <cmath>
+
+/**
+ * @brief Advances one GBM path through num_steps steps with constant mu and sigma.
+ *
+ * Templated on the number type; run_single_simulation instantiates it on
+ * double. z holds the path's standard normals for these steps.
+ */
+template <class Real>
+Real advance_gbm_path(Real price, const Real& mu, const Real& sigma, double dt, const double* z, int num_steps) {
+    using std::exp;
+    const double sqrt_dt = std::sqrt(dt);
+    const Real drift_dt = (mu - 0.5 * sigma * sigma) * dt;
+    const Real vol_sqrt_dt = sigma * sqrt_dt;
+    for (int i = 0; i < num_steps; ++i) {
+        // S_t = S_{t-1} * exp( (mu - 0.5 * sigma^2) * dt + sigma * Z * sqrt(dt) )
+        price = price * exp(drift_dt + vol_sqrt_dt * z[i]);
+    }
+    return price;
+}
+
+#endif // GBM_PATH_H
@@ -0,0 +1,32 @@
+#include "gbm_path_engine.h"
+
+PrecisionBias measure_precision_bias(MonteCarloEngine& engine, const GbmParameters& params, std::size_t num_paths,
+                                     const std::function<double(double)>& payoff) {
+    // Keep both sets of final prices; paths are paired by index
+    std::vector<double> reference_prices(num_paths);
+    std::vector<float> single_prices(num_paths);
+    GbmPathEngine<double>(engine).for_each_block(params, num_paths, [&](std::size_t first_path,
+                                                                         const double* prices, std::size_t count,
+                                                                         unsigned) {
+        std::copy(prices, prices + count, reference_prices.begin() + first_path);
+    });
+    GbmPathEngine<float>(engine).for_each_block(params, num_paths, [&](std::size_t first_path, const float* prices,
+                                                                        std::size_t count, unsigned) {
+        std::copy(prices, prices + count, single_prices.begin() + first_path);
+    });
+
+    RunningStats reference, difference;
+    PrecisionBias result;
+    for (std::size_t p = 0; p < num_paths; ++p) {
+        const double exact = payoff(reference_prices[p]);
+        reference.add(exact);
+        difference.add(payoff(static_cast<double>(single_prices[p])) - exact);
+        const double relative = std::fabs(static_cast<double>(single_prices[p]) / reference_prices[p] - 1.0);
+        result.max_relative_price_error = std::max(result.max_relative_price_error, relative);
+    }
+    result.reference = reference.mean();
+    result.bias = difference.mean();
+    result.bias_std_error = difference.std_error();
+    result.bound = std::fabs(result.bias) + 3.0 * result.bias_std_error;
+    return result;
+}
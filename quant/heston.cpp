@@ -0,0 +1,112 @@
+#include "heston.h"
+
+#include <cmath>
+#include <complex>
+
+#include "normal_math.h"
+
+HestonProcess::HestonProcess(const HestonParameters& params) : params(params) {}
+
+void HestonProcess::initialize(double* state, std::size_t count) const {
+    double* prices = state;
+    double* variances = state + count;
+    for (std::size_t p = 0; p < count; ++p) {
+        prices[p] = params.S0;
+        variances[p] = params.v0;
+    }
+}
+
+void HestonProcess::step(double* state, const double* const* z, std::size_t count, double dt) const {
+    const double kappa = params.kappa;
+    const double theta = params.theta;
+    const double xi = params.xi;
+    const double rho = params.rho;
+
+    // Per-step constants of the conditional variance moments and the log-price update
+    const double decay = std::exp(-kappa * dt);
+    const double var_from_v = xi * xi * decay * (1.0 - decay) / kappa;
+    const double var_from_theta = theta * xi * xi * (1.0 - decay) * (1.0 - decay) / (2.0 * kappa);
+    const double k0 = -rho * kappa * theta * dt / xi + params.r * dt;
+    const double k1 = 0.5 * dt * (kappa * rho / xi - 0.5) - rho / xi;
+    const double k2 = 0.5 * dt * (kappa * rho / xi - 0.5) + rho / xi;
+    const double k3 = 0.5 * dt * (1.0 - rho * rho);
+    const double psi_switch = 1.5;
+
+    double* prices = state;
+    double* variances = state + count;
+    const double* z_variance = z[0];
+    const double* z_price = z[1];
+    for (std::size_t p = 0; p < count; ++p) {
+        const double v = variances[p];
+        const double m = theta + (v - theta) * decay;
+        const double s2 = v * var_from_v + var_from_theta;
+        const double psi = s2 / (m * m);
+
+        double next;
+        if (psi <= psi_switch) {
+            // Quadratic: a (b + Z)^2 matches the conditional mean and variance
+            const double inv_psi = 2.0 / psi;
+            const double b2 = inv_psi - 1.0 + std::sqrt(inv_psi) * std::sqrt(inv_psi - 1.0);
+            const double a = m / (1.0 + b2);
+            const double shifted = std::sqrt(b2) + z_variance[p];
+            next = a * shifted * shifted;
+        } else {
+            // Exponential with a point mass at zero, sampled from U = N(Z)
+            const double mass = (psi - 1.0) / (psi + 1.0);
+            const double beta = (1.0 - mass) / m;
+            next = (normal_cdf(z_variance[p]) <= mass) ? 0.0
+                 : std::log((1.0 - mass) / normal_cdf(-z_variance[p])) / beta;
+        }
+
+        prices[p] *= std::exp(k0 + k1 * v + k2 * next + std::sqrt(k3 * (v + next)) * z_price[p]);
+        variances[p] = next;
+    }
+}
+
+double heston_price(OptionType type, const HestonParameters& params, double strike, double T) {
+    using Complex = std::complex<double>;
+    const Complex i(0.0, 1.0);
+    const double kappa = params.kappa;
+    const double xi = params.xi;
+    const double log_forward = std::log(params.S0) + params.r * T;
+
+    // Characteristic function of log S_T
+    auto characteristic = [&](Complex u) {
+        const Complex beta = kappa - params.rho * xi * i * u;
+        const Complex d = std::sqrt(beta * beta + xi * xi * (i * u + u * u));
+        const Complex g = (beta - d) / (beta + d);
+        const Complex decay = std::exp(-d * T);
+        const Complex c = kappa * params.theta / (xi * xi)
+                        * ((beta - d) * T - 2.0 * std::log((1.0 - g * decay) / (1.0 - g)));
+        const Complex dv = params.v0 / (xi * xi) * (beta - d) * (1.0 - decay) / (1.0 - g * decay);
+        return std::exp(i * u * log_forward + c + dv);
+    };
+
+    // P1 and P2: probabilities of finishing in the money under the stock and money-market measures
+    const double log_strike = std::log(strike);
+    const double forward = std::exp(log_forward);
+    auto integrand = [&](double u, bool stock_measure) {
+        const Complex phi = stock_measure ? characteristic(Complex(u, -1.0)) / forward : characteristic(u);
+        return std::real(std::exp(-i * u * log_strike) * phi / (i * u));
+    };
+
+    // Composite Simpson's rule; the integrand is smooth and decays quickly
+    const int intervals = 4096;
+    const double upper = 200.0;
+    const double lower = 1e-8;
+    const double h = (upper - lower) / intervals;
+    double p1 = 0.0, p2 = 0.0;
+    for (int k = 0; k <= intervals; ++k) {
+        const double u = lower + k * h;
+        const double weight = (k == 0 || k == intervals) ? 1.0 : ((k % 2) ? 4.0 : 2.0);
+        p1 += weight * integrand(u, true);
+        p2 += weight * integrand(u, false);
+    }
+    const double pi = 3.14159265358979323846;
+    p1 = 0.5 + p1 * h / 3.0 / pi;
+    p2 = 0.5 + p2 * h / 3.0 / pi;
+
+    const double discount = std::exp(-params.r * T);
+    const double call = params.S0 * p1 - strike * discount * p2;
+    return (type == OptionType::Call) ? call : call - params.S0 + strike * discount;
+}
@@ -0,0 +1,187 @@
+#include "instrumentation.h"
+
+#include <iomanip>
+#include <ostream>
+
+#if defined(QUANT_INSTRUMENT)
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#endif
+
+const char* phase_name(Phase phase) {
+    switch (phase) {
+        case Phase::Task:
+            return "task";
+        case Phase::Rng:
+            return "rng";
+        case Phase::Step:
+            return "step";
+        case Phase::Payoff:
+            return "payoff";
+        case Phase::Reduction:
+            return "reduction";
+        default:
+            return "unknown";
+    }
+}
+
+#if defined(QUANT_INSTRUMENT)
+
+namespace {
+
+std::atomic<std::uint64_t> bytes_allocated{0};
+std::atomic<std::uint64_t> allocations{0};
+
+// Counters of every thread that ever entered a phase. Records are never
+// freed, so a pointer cached by a thread stays valid for the thread's life.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadPhaseTimes>> threads;
+    std::chrono::steady_clock::time_point start_time;
+    std::uint64_t start_cycles = 0;
+    std::uint64_t start_bytes = 0;
+    std::uint64_t start_allocations = 0;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+thread_local ThreadPhaseTimes* current_thread_times = nullptr;
+
+} // namespace
+
+ThreadPhaseTimes& this_thread_phase_times() {
+    if (!current_thread_times) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(std::make_unique<ThreadPhaseTimes>());
+        current_thread_times = r.threads.back().get();
+    }
+    return *current_thread_times;
+}
+
+void begin_instrumented_run() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& times : r.threads) {
+        *times = ThreadPhaseTimes();
+    }
+    r.start_bytes = bytes_allocated.load(std::memory_order_relaxed);
+    r.start_allocations = allocations.load(std::memory_order_relaxed);
+    r.start_time = std::chrono::steady_clock::now();
+    r.start_cycles = read_cycle_counter();
+}
+
+InstrumentationReport end_instrumented_run(std::uint64_t paths, unsigned num_threads) {
+    const std::uint64_t end_cycles = read_cycle_counter();
+    const auto end_time = std::chrono::steady_clock::now();
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    InstrumentationReport report;
+    report.enabled = true;
+    report.wall_seconds = std::chrono::duration<double>(end_time - r.start_time).count();
+    report.cycles_per_second = (report.wall_seconds > 0.0)
+                             ? static_cast<double>(end_cycles - r.start_cycles) / report.wall_seconds : 0.0;
+    report.paths = paths;
+    report.paths_per_second = (report.wall_seconds > 0.0) ? static_cast<double>(paths) / report.wall_seconds : 0.0;
+    report.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed) - r.start_bytes;
+    report.allocations = allocations.load(std::memory_order_relaxed) - r.start_allocations;
+    report.num_threads = num_threads;
+
+    for (const auto& times : r.threads) {
+        std::uint64_t entered = 0;
+        for (std::size_t k = 0; k < kNumPhases; ++k) {
+            entered += times->calls[k];
+            report.total.cycles[k] += times->cycles[k];
+            report.total.calls[k] += times->calls[k];
+        }
+        if (entered > 0) {
+            report.threads.push_back(*times);
+        }
+    }
+
+    const double capacity = static_cast<double>(end_cycles - r.start_cycles) * static_cast<double>(num_threads);
+    const std::size_t task = static_cast<std::size_t>(Phase::Task);
+    report.parallel_efficiency = (capacity > 0.0) ? static_cast<double>(report.total.cycles[task]) / capacity : 0.0;
+    return report;
+}
+
+// Counting replacements of the global allocation functions; the array and
+// nothrow forms forward to these
+void* operator new(std::size_t size) {
+    bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#else
+
+void begin_instrumented_run() {}
+
+InstrumentationReport end_instrumented_run(std::uint64_t paths, unsigned num_threads) {
+    InstrumentationReport report;
+    report.paths = paths;
+    report.num_threads = num_threads;
+    return report;
+}
+
+#endif
+
+namespace {
+
+void write_phases(std::ostream& out, const ThreadPhaseTimes& times, double cycles_per_second) {
+    out << "{";
+    for (std::size_t k = 0; k < kNumPhases; ++k) {
+        const double seconds = (cycles_per_second > 0.0) ? static_cast<double>(times.cycles[k]) / cycles_per_second
+                                                         : 0.0;
+        out << (k ? ", " : "") << "\"" << phase_name(static_cast<Phase>(k)) << "\": {\"calls\": " << times.calls[k]
+            << ", \"cycles\": " << times.cycles[k] << ", \"seconds\": " << seconds << "}";
+    }
+    out << "}";
+}
+
+} // namespace
+
+void write_instrumentation_json(std::ostream& out, const InstrumentationReport& report) {
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::defaultfloat << std::setprecision(9);
+    out << "{\n";
+    out << "  \"enabled\": " << (report.enabled ? "true" : "false") << ",\n";
+    out << "  \"wall_seconds\": " << report.wall_seconds << ",\n";
+    out << "  \"cycles_per_second\": " << report.cycles_per_second << ",\n";
+    out << "  \"paths\": " << report.paths << ",\n";
+    out << "  \"paths_per_second\": " << report.paths_per_second << ",\n";
+    out << "  \"bytes_allocated\": " << report.bytes_allocated << ",\n";
+    out << "  \"allocations\": " << report.allocations << ",\n";
+    out << "  \"num_threads\": " << report.num_threads << ",\n";
+    out << "  \"parallel_efficiency\": " << report.parallel_efficiency << ",\n";
+    out << "  \"phases\": ";
+    write_phases(out, report.total, report.cycles_per_second);
+    out << ",\n  \"threads\": [";
+    for (std::size_t t = 0; t < report.threads.size(); ++t) {
+        out << (t ? ",\n    " : "\n    ");
+        write_phases(out, report.threads[t], report.cycles_per_second);
+    }
+    out << (report.threads.empty() ? "]\n" : "\n  ]\n") << "}" << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
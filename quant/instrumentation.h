@@ -0,0 +1,112 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#if defined(QUANT_INSTRUMENT) && (defined(__x86_64__) || defined(_M_X64))
+#include <x86intrin.h>
+#elif defined(QUANT_INSTRUMENT)
+#include <chrono>
+#endif
+
+// Stages of the simulation pipeline that are timed separately
+enum class Phase {
+    Task,       // Everything a pool worker runs: its busy time, which contains the phases below
+    Rng,        // Pseudo-random normals, Sobol points and the Brownian bridge
+    Step,       // Step kernels and process steps
+    Payoff,     // Observers and block consumers: payoff state, payoffs and their accumulation
+    Reduction,  // Merging per-worker or per-block accumulators
+    Count
+};
+
+constexpr std::size_t kNumPhases = static_cast<std::size_t>(Phase::Count);
+
+// Lower-case name of a phase ("task", "rng", "step", "payoff", "reduction")
+const char* phase_name(Phase phase);
+
+// Cycles and scope entries of one thread, per phase
+struct ThreadPhaseTimes {
+    std::uint64_t cycles[kNumPhases] = {};
+    std::uint64_t calls[kNumPhases] = {};
+};
+
+/**
+ * @brief What an instrumented run spent where.
+ *
+ * Cycles come from the time-stamp counter (nanoseconds where there is none)
+ * and are converted to seconds at the counter rate measured over the run.
+ * Allocation counts cover every operator new in the process during the run.
+ * Parallel efficiency is the workers' busy time over threads x wall time.
+ */
+struct InstrumentationReport {
+    bool enabled = false;               // False when the build compiled instrumentation out
+    double wall_seconds = 0.0;
+    double cycles_per_second = 0.0;
+    std::uint64_t paths = 0;
+    double paths_per_second = 0.0;
+    std::uint64_t bytes_allocated = 0;
+    std::uint64_t allocations = 0;
+    unsigned num_threads = 0;
+    double parallel_efficiency = 0.0;
+    ThreadPhaseTimes total;                 // Summed over threads
+    std::vector<ThreadPhaseTimes> threads;  // Every thread that entered a phase during the run
+};
+
+// Zeroes the counters and starts the clocks; runs must not overlap
+void begin_instrumented_run();
+
+// Stops the clocks and collects the counters of a run that simulated `paths` paths on num_threads threads
+InstrumentationReport end_instrumented_run(std::uint64_t paths, unsigned num_threads);
+
+// Writes the report as one JSON object
+void write_instrumentation_json(std::ostream& out, const InstrumentationReport& report);
+
+#if defined(QUANT_INSTRUMENT)
+
+inline std::uint64_t read_cycle_counter() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// The calling thread's counters, registered on first use
+ThreadPhaseTimes& this_thread_phase_times();
+
+// Adds the cycles between construction and destruction to the thread's phase
+class ScopedPhase {
+public:
+    explicit ScopedPhase(Phase phase) : index(static_cast<std::size_t>(phase)), start(read_cycle_counter()) {}
+
+    ~ScopedPhase() {
+        ThreadPhaseTimes& times = this_thread_phase_times();
+        times.cycles[index] += read_cycle_counter() - start;
+        ++times.calls[index];
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    std::size_t index;
+    std::uint64_t start;
+};
+
+#define QUANT_CONCAT_IMPL(a, b) a##b
+#define QUANT_CONCAT(a, b) QUANT_CONCAT_IMPL(a, b)
+// Times the rest of the enclosing scope as `phase`
+#define QUANT_PHASE_SCOPE(phase) ScopedPhase QUANT_CONCAT(phase_scope_, __LINE__)(phase)
+
+#else
+
+// Instrumentation is off: the scopes compile to nothing
+#define QUANT_PHASE_SCOPE(phase) static_cast<void>(0)
+
+#endif
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,89 @@
+#include "merton.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "normal_math.h"
+
+namespace {
+
+// Lanes tested together before any jump work is done; one AVX-512 register of doubles
+const std::size_t kJumpLanes = 8;
+
+// Expected relative jump size E[J - 1]
+double mean_jump(const MertonParameters& params) {
+    return std::exp(params.jump_mean + 0.5 * params.jump_vol * params.jump_vol) - 1.0;
+}
+
+} // namespace
+
+MertonProcess::MertonProcess(const MertonParameters& params, SimdIsa isa)
+    : params(params), kernel(select_gbm_step_kernel(isa)) {}
+
+void MertonProcess::initialize(double* state, std::size_t count) const {
+    std::fill(state, state + count, params.S0);
+}
+
+void MertonProcess::step(double* state, const double* const* z, std::size_t count, double dt) const {
+    // Diffusion, with the drift lowered by lambda * E[J - 1] to pay for the jumps
+    const double drift = params.r - params.lambda * mean_jump(params) - 0.5 * params.sigma * params.sigma;
+    kernel(state, z[0], count, drift * dt, params.sigma * std::sqrt(dt));
+
+    // A path has at least one jump when N(z) < P(at least one jump), i.e. z < threshold
+    const double intensity = params.lambda * dt;
+    if (intensity <= 0.0) {
+        return;
+    }
+    const double no_jump = std::exp(-intensity);
+    const double threshold = inverse_normal_cdf(-std::expm1(-intensity));
+    const double* z_count = z[1];
+    const double* z_size = z[2];
+
+    for (std::size_t group = 0; group < count; group += kJumpLanes) {
+        const std::size_t end = std::min(group + kJumpLanes, count);
+        bool any_jump = false;
+        for (std::size_t p = group; p < end; ++p) {
+            any_jump |= z_count[p] < threshold;
+        }
+        if (!any_jump) {
+            continue;
+        }
+        for (std::size_t p = group; p < end; ++p) {
+            if (z_count[p] >= threshold) {
+                continue;
+            }
+            // N is the smallest n with P(N > n) <= N(z); working with upper tails
+            // keeps full precision in the small probabilities involved
+            const double tail = normal_cdf(z_count[p]);
+            double term = no_jump;                  // P(N = n)
+            double upper = -std::expm1(-intensity); // P(N > n)
+            int jumps = 0;
+            do {
+                ++jumps;
+                term *= intensity / jumps;
+                upper -= term;
+            } while (upper > tail && term > 0.0);
+            const double n = static_cast<double>(jumps);
+            state[p] *= std::exp(n * params.jump_mean + std::sqrt(n) * params.jump_vol * z_size[p]);
+        }
+    }
+}
+
+double merton_price(OptionType type, const MertonParameters& params, double strike, double T) {
+    const double k = mean_jump(params);
+    const double jump_intensity = params.lambda * (1.0 + k) * T;
+    double price = 0.0;
+    double weight = std::exp(-jump_intensity);     // Poisson probability of n jumps
+    for (int n = 0; n < 200; ++n) {
+        if (n > 0) {
+            weight *= jump_intensity / n;
+        }
+        const double sigma_n = std::sqrt(params.sigma * params.sigma + n * params.jump_vol * params.jump_vol / T);
+        const double rate_n = params.r - params.lambda * k + n * std::log(1.0 + k) / T;
+        price += weight * black_scholes(type, params.S0, strike, rate_n, sigma_n, T).price;
+        if (n > jump_intensity && weight < 1e-16) {
+            break;
+        }
+    }
+    return price;
+}
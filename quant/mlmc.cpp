@@ -0,0 +1,194 @@
+#include "mlmc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "gbm_kernel.h"
+#include "philox.h"
+#include "streaming_stats.h"
+
+namespace {
+
+// What a reduction slot accumulates on one level
+struct LevelSums {
+    RunningStats correction;    // P_fine - P_coarse
+    RunningStats fine;          // P_fine alone, for the single-level comparison
+
+    void merge(const LevelSums& other) {
+        correction.merge(other.correction);
+        fine.merge(other.fine);
+    }
+};
+
+double level_cost(int level) {
+    const double fine_steps = std::ldexp(1.0, level);
+    return (level == 0) ? fine_steps : 1.5 * fine_steps;
+}
+
+// Simulates paths [first_path, first_path + num_paths) of a level and adds them to sums
+void simulate_level(MonteCarloEngine& engine, const GbmParameters& params, const PathPayoff& payoff, int level,
+                    std::uint64_t first_path, std::size_t num_paths, LevelSums& sums) {
+    const std::size_t fine_steps = std::size_t(1) << level;
+    const double dt = params.T / static_cast<double>(fine_steps);
+    const double fine_drift = (params.mu - 0.5 * params.sigma * params.sigma) * dt;
+    const double fine_vol = params.sigma * std::sqrt(dt);
+    const double coarse_drift = 2.0 * fine_drift;
+    const double coarse_vol = fine_vol * std::sqrt(2.0);
+    const double discount = std::exp(-params.mu * params.T);
+    const std::size_t state_size = payoff.state_size();
+
+    const GbmStepKernel kernel = select_gbm_step_kernel(engine.isa());
+    const PathNormalGenerator normals(engine.seed(), static_cast<std::uint32_t>(level), engine.isa());
+    const std::size_t block_size = engine.block_size();
+    const std::size_t num_blocks = (num_paths + block_size - 1) / block_size;
+    std::vector<LevelSums> slots(engine.reduction_slots(num_paths));
+
+    engine.thread_pool().parallel_for(num_blocks, [&](std::size_t block, unsigned worker) {
+        const std::size_t begin = block * block_size;
+        const std::size_t count = std::min(block_size, num_paths - begin);
+        std::vector<double> fine(count, params.S0), coarse(count, params.S0);
+        std::vector<double> fine_state(state_size * count), coarse_state(state_size * count);
+        std::vector<double> z(kStepTile * count), coarse_z(count);
+        payoff.initialize(fine_state.data(), count, params.S0);
+        payoff.initialize(coarse_state.data(), count, params.S0);
+
+        for (std::size_t tile_start = 0; tile_start < fine_steps; tile_start += kStepTile) {
+            const std::size_t tile_steps = std::min(kStepTile, fine_steps - tile_start);
+            normals.fill_block(first_path + begin, count, static_cast<std::uint32_t>(tile_start), tile_steps,
+                               z.data());
+            for (std::size_t s = 0; s < tile_steps; ++s) {
+                const double* zs = &z[s * count];
+                kernel(fine.data(), zs, count, fine_drift, fine_vol);
+                payoff.update(fine_state.data(), fine.data(), count, tile_start + s + 1);
+
+                // The coarse path takes one step per pair of fine steps, on the same Brownian motion
+                if (level > 0 && s % 2 == 1) {
+                    const double* previous = zs - count;
+                    for (std::size_t p = 0; p < count; ++p) {
+                        coarse_z[p] = (previous[p] + zs[p]) * M_SQRT1_2;
+                    }
+                    kernel(coarse.data(), coarse_z.data(), count, coarse_drift, coarse_vol);
+                    payoff.update(coarse_state.data(), coarse.data(), count, (tile_start + s + 1) / 2);
+                }
+            }
+        }
+
+        std::vector<double> fine_payoff(count), coarse_payoff(count, 0.0);
+        payoff.payoff(fine_state.data(), fine.data(), count, fine_payoff.data());
+        if (level > 0) {
+            payoff.payoff(coarse_state.data(), coarse.data(), count, coarse_payoff.data());
+        }
+        LevelSums& local = slots[engine.reduction_slot(begin, worker)];
+        for (std::size_t p = 0; p < count; ++p) {
+            const double fine_value = discount * fine_payoff[p];
+            local.fine.add(fine_value);
+            local.correction.add(fine_value - discount * coarse_payoff[p]);
+        }
+    });
+
+    sums.merge(merge_pairwise(slots));
+}
+
+// Weak order alpha from a least-squares fit of log2 |mean_l| against l (levels >= 1)
+double weak_order(const std::vector<LevelSums>& sums) {
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, n = 0.0;
+    for (std::size_t l = 1; l < sums.size(); ++l) {
+        const double mean = std::fabs(sums[l].correction.mean());
+        if (mean <= 0.0) {
+            continue;
+        }
+        const double x = static_cast<double>(l);
+        const double y = std::log2(mean);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+        n += 1.0;
+    }
+    if (n < 2.0) {
+        return 1.0;
+    }
+    const double slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    return std::max(0.5, -slope);
+}
+
+} // namespace
+
+MlmcResult run_mlmc(MonteCarloEngine& engine, const GbmParameters& params, const PathPayoff& payoff,
+                    const MlmcConfig& config) {
+    const double epsilon = config.target_rmse;
+    const int max_levels = std::max(config.max_levels, 2);
+    std::vector<LevelSums> sums(std::clamp(config.min_levels, 2, max_levels));
+    std::vector<std::size_t> extra(sums.size(), config.initial_paths);
+
+    bool converged = false;
+    double bias = 0.0;
+    for (;;) {
+        // Run the paths still owed to each level
+        for (std::size_t l = 0; l < sums.size(); ++l) {
+            if (extra[l] > 0) {
+                simulate_level(engine, params, payoff, static_cast<int>(l), sums[l].correction.count(), extra[l],
+                               sums[l]);
+            }
+        }
+
+        // Optimal allocation for a sampling variance of epsilon^2 / 2:
+        // N_l = 2 / epsilon^2 * sqrt(V_l / C_l) * sum_k sqrt(V_k C_k)
+        double total = 0.0;
+        for (std::size_t l = 0; l < sums.size(); ++l) {
+            total += std::sqrt(std::max(sums[l].correction.variance(), 1e-14) * level_cost(static_cast<int>(l)));
+        }
+        bool more = false;
+        for (std::size_t l = 0; l < sums.size(); ++l) {
+            const double variance = std::max(sums[l].correction.variance(), 1e-14);
+            const double wanted = std::ceil(2.0 / (epsilon * epsilon) *
+                                            std::sqrt(variance / level_cost(static_cast<int>(l))) * total);
+            const double done = static_cast<double>(sums[l].correction.count());
+            extra[l] = (wanted > done) ? static_cast<std::size_t>(wanted - done) : 0;
+            more = more || extra[l] > 0;
+        }
+        if (more) {
+            continue;
+        }
+
+        // Remaining bias ~ mean_L / (2^alpha - 1); the second-finest level steadies the estimate
+        const double alpha = weak_order(sums);
+        const double factor = std::exp2(alpha);
+        const std::size_t finest = sums.size() - 1;
+        bias = std::max(std::fabs(sums[finest].correction.mean()),
+                        std::fabs(sums[finest - 1].correction.mean()) / factor) / (factor - 1.0);
+        if (bias <= epsilon / M_SQRT2) {
+            converged = true;
+            break;
+        }
+        if (static_cast<int>(sums.size()) >= max_levels) {
+            break;
+        }
+        sums.emplace_back();
+        extra.push_back(config.initial_paths);
+    }
+
+    MlmcResult result;
+    result.converged = converged;
+    double sampling_variance = 0.0;
+    for (std::size_t l = 0; l < sums.size(); ++l) {
+        MlmcLevel level;
+        level.steps = 1 << l;
+        level.paths = static_cast<std::size_t>(sums[l].correction.count());
+        level.mean = sums[l].correction.mean();
+        level.variance = sums[l].correction.variance();
+        level.cost_per_path = level_cost(static_cast<int>(l));
+        result.value += level.mean;
+        result.cost += level.cost_per_path * static_cast<double>(level.paths);
+        sampling_variance += level.variance / static_cast<double>(level.paths);
+        result.levels.push_back(level);
+    }
+    result.rmse = std::sqrt(sampling_variance + bias * bias);
+
+    // Plain MC on the finest grid with the same sampling variance budget
+    const RunningStats& finest = sums.back().fine;
+    result.single_level_cost = 2.0 * finest.variance() / (epsilon * epsilon) *
+                               static_cast<double>(result.levels.back().steps);
+    return result;
+}
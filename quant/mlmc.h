@@ -0,0 +1,56 @@
+#ifndef MLMC_H
+#define MLMC_H
+
+#include <cstddef>
+#include <vector>
+
+#include "monte_carlo_engine.h"
+#include "path_payoffs.h"
+
+// Settings of the multilevel driver
+struct MlmcConfig {
+    double target_rmse = 0.01;          // Root-mean-square error to reach (bias and noise together)
+    int min_levels = 3;                 // Levels always simulated (level l has 2^l steps)
+    int max_levels = 12;                // Finest level allowed is max_levels - 1
+    std::size_t initial_paths = 4096;   // Pilot paths on every new level
+};
+
+// What one level contributed
+struct MlmcLevel {
+    int steps = 0;                  // Fine steps per path on this level
+    std::size_t paths = 0;
+    double mean = 0.0;              // Mean of P_fine - P_coarse (of P_fine on level 0)
+    double variance = 0.0;          // Variance of the same
+    double cost_per_path = 0.0;     // Fine plus coarse steps
+};
+
+struct MlmcResult {
+    double value = 0.0;
+    double rmse = 0.0;                  // Estimated: sampling error plus estimated bias
+    bool converged = false;             // False if max_levels was reached before the bias test passed
+    std::vector<MlmcLevel> levels;
+    double cost = 0.0;                  // Total simulated steps
+    double single_level_cost = 0.0;     // Steps plain MC on the finest level would need for the same error
+};
+
+/**
+ * @brief Multilevel Monte Carlo estimate of a discounted path-dependent payoff (Giles, 2008).
+ *
+ * params.mu is the risk-free rate; params.steps is ignored, since the levels
+ * set the resolution: level l walks 2^l exact GBM steps. Above level 0 each
+ * path is simulated twice from the same Brownian increments, on the fine grid
+ * and on the coarse grid of half as many steps (whose normals are the
+ * normalized sums of pairs of fine ones), and only the difference of the two
+ * payoffs is sampled. These corrections have small variance, so the expensive
+ * fine levels need few paths.
+ *
+ * After pilot runs the number of paths per level is set to the optimum
+ * N_l ~ sqrt(V_l / C_l) that gives a sampling variance of rmse^2 / 2 at the
+ * least cost. Levels are added until the bias estimated from the finest
+ * corrections falls below rmse / sqrt(2). Each level draws from its own
+ * stream of the engine's counter-based generator and runs on its threads.
+ */
+MlmcResult run_mlmc(MonteCarloEngine& engine, const GbmParameters& params, const PathPayoff& payoff,
+                    const MlmcConfig& config = MlmcConfig());
+
+#endif // MLMC_H
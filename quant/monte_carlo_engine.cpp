@@ -0,0 +1,549 @@
+#include "monte_carlo_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "brownian_bridge.h"
+#include "gbm_path.h"
+#include "instrumentation.h"
+#include "normal_math.h"
+#include "sobol.h"
+
+namespace {
+
+// Paths per quasi-random sub-batch; each holds a full set of increments per path
+const std::size_t kQmcBatch = 256;
+
+// Derives a non-zero Sobol scrambling seed for one RQMC replicate
+std::uint64_t scramble_seed(std::uint64_t seed, std::uint32_t replicate) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ull * (static_cast<std::uint64_t>(replicate) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return z != 0 ? z : 1;
+}
+
+} // namespace
+
+double run_single_simulation(double S0, double mu, double sigma, double T, int steps,
+                             const PathNormalGenerator& normals, std::uint64_t path) {
+
+    double dt = T / steps; // The size of a single time step
+
+    // Draw every standard normal (Z) this path needs in one bulk call
+    std::vector<double> z(steps);
+    normals.fill_path(path, 0, steps, z.data());
+
+    // Apply the Geometric Brownian Motion formula step by step
+    return advance_gbm_path<double>(S0, mu, sigma, dt, z.data(), steps);
+}
+
+MonteCarloEngine::MonteCarloEngine(const EngineConfig& config)
+    : config(config), pool(config.num_threads), step_kernel(select_gbm_step_kernel(config.isa)) {
+    if (this->config.block_size == 0) {
+        this->config.block_size = 1;
+    }
+    // Antithetic pairs must not straddle two blocks
+    const bool antithetic = config.variance_reduction.antithetic && config.sampling != SamplingMode::QuasiRandom;
+    if (antithetic && this->config.block_size % 2 != 0) {
+        ++this->config.block_size;
+    }
+    if (!simd_isa_supported(this->config.isa)) {
+        this->config.isa = SimdIsa::Scalar;
+    }
+}
+
+unsigned MonteCarloEngine::num_threads() const {
+    return pool.size();
+}
+
+SimdIsa MonteCarloEngine::isa() const {
+    return config.isa;
+}
+
+std::uint64_t MonteCarloEngine::seed() const {
+    return config.seed;
+}
+
+std::size_t MonteCarloEngine::block_size() const {
+    return config.block_size;
+}
+
+bool MonteCarloEngine::reproducible() const {
+    return config.reproducible;
+}
+
+SamplingMode MonteCarloEngine::sampling() const {
+    return config.sampling;
+}
+
+const VarianceReduction& MonteCarloEngine::variance_reduction() const {
+    return config.variance_reduction;
+}
+
+bool MonteCarloEngine::exact_terminal() const {
+    return config.exact_terminal;
+}
+
+std::size_t MonteCarloEngine::reduction_slots(std::size_t num_paths) const {
+    return reduction_slots(num_paths, config.block_size);
+}
+
+std::size_t MonteCarloEngine::reduction_slot(std::size_t path_offset, unsigned worker) const {
+    return reduction_slot(path_offset, worker, config.block_size);
+}
+
+std::size_t MonteCarloEngine::reduction_slots(std::size_t num_paths, std::size_t block_size) const {
+    return config.reproducible ? std::max<std::size_t>((num_paths + block_size - 1) / block_size, 1) : pool.size();
+}
+
+std::size_t MonteCarloEngine::reduction_slot(std::size_t path_offset, unsigned worker, std::size_t block_size) const {
+    return config.reproducible ? path_offset / block_size : worker;
+}
+
+ThreadPool& MonteCarloEngine::thread_pool() {
+    return pool;
+}
+
+MonteCarloEngine::TimeGrid MonteCarloEngine::terminal_grid(const GbmParameters& params) const {
+    // Under GBM, log S_T is exactly normal, so when only S_T is needed one step
+    // of length T gives the same distribution as params.steps small ones
+    const std::size_t steps = static_cast<std::size_t>(std::max(params.steps, 1));
+    TimeGrid grid;
+    if (config.exact_terminal) {
+        grid.steps.push_back(steps);
+    } else {
+        for (std::size_t s = 1; s <= steps; ++s) {
+            grid.steps.push_back(s);
+        }
+    }
+    grid.observed.assign(grid.steps.size(), 0);
+    return grid;
+}
+
+MonteCarloEngine::TimeGrid MonteCarloEngine::observation_grid(const GbmParameters& params,
+                                                              std::vector<std::size_t> observation_steps) const {
+    const std::size_t steps = static_cast<std::size_t>(std::max(params.steps, 1));
+    TimeGrid grid;
+    if (observation_steps.empty()) {
+        for (std::size_t s = 1; s <= steps; ++s) {
+            grid.steps.push_back(s);
+        }
+        grid.observed.assign(steps, 1);
+        return grid;
+    }
+
+    for (std::size_t& step : observation_steps) {
+        step = std::min(std::max<std::size_t>(step, 1), steps);
+    }
+    std::sort(observation_steps.begin(), observation_steps.end());
+    observation_steps.erase(std::unique(observation_steps.begin(), observation_steps.end()), observation_steps.end());
+
+    // Exact sampling jumps from one observed step to the next; otherwise walk
+    // every step up to the last observation
+    if (config.exact_terminal) {
+        grid.steps = observation_steps;
+        grid.observed.assign(grid.steps.size(), 1);
+    } else {
+        std::size_t next = 0;
+        for (std::size_t s = 1; s <= observation_steps.back(); ++s) {
+            const bool observed = observation_steps[next] == s;
+            grid.steps.push_back(s);
+            grid.observed.push_back(observed ? 1 : 0);
+            next += observed ? 1 : 0;
+        }
+    }
+    return grid;
+}
+
+MonteCarloEngine::BlockWalk MonteCarloEngine::make_walk(const GbmParameters& params, const TimeGrid& grid,
+                                                        std::uint32_t replicate, bool want_weights) const {
+    const VarianceReduction& reduction = config.variance_reduction;
+    BlockWalk walk;
+    walk.params = params;
+    walk.grid = grid;
+    walk.quasi_random = config.sampling == SamplingMode::QuasiRandom;
+    walk.antithetic = reduction.antithetic && !walk.quasi_random;
+    walk.want_weights = want_weights;
+    walk.theta = reduction.importance_shift;
+    walk.track_weights = want_weights && walk.theta != 0.0;
+    const std::size_t steps = grid.steps.size();
+
+    // Hoist the per-step constants out of the kernel. A simulated step that
+    // spans k fine steps is exact under GBM, and the shift theta on each of its
+    // fine normals becomes theta * sqrt(k) on its single normal, which leaves
+    // the likelihood ratio unchanged. Drawing every normal from N(theta_j, 1)
+    // is the same as adding theta_j to the drift.
+    const double fine_dt = params.T / static_cast<double>(std::max(params.steps, 1));
+    walk.drift_dt.resize(steps);
+    walk.vol_sqrt_dt.resize(steps);
+    walk.step_shift.resize(steps);
+    for (std::size_t j = 0; j < steps; ++j) {
+        const double span = static_cast<double>(grid.steps[j] - ((j > 0) ? grid.steps[j - 1] : 0));
+        const double dt = span * fine_dt;
+        walk.step_shift[j] = walk.theta * std::sqrt(span);
+        walk.vol_sqrt_dt[j] = params.sigma * std::sqrt(dt);
+        walk.drift_dt[j] = (params.mu - 0.5 * params.sigma * params.sigma) * dt
+                         + walk.vol_sqrt_dt[j] * walk.step_shift[j];
+    }
+    walk.fine_steps = static_cast<double>(grid.steps.back());
+
+    if (walk.quasi_random) {
+        walk.sobol = std::make_shared<const SobolSequence>(steps, scramble_seed(config.seed, replicate));
+        walk.bridge = std::make_shared<const BrownianBridge>(std::vector<double>(grid.steps.begin(), grid.steps.end()));
+    }
+    return walk;
+}
+
+MonteCarloEngine::BlockWalk MonteCarloEngine::prepare_walk(const GbmParameters& params,
+                                                           const std::vector<std::size_t>& observation_steps,
+                                                           std::uint32_t replicate) const {
+    return make_walk(params, observation_grid(params, observation_steps), replicate, true);
+}
+
+void MonteCarloEngine::walk_block(const BlockWalk& walk, std::size_t first_path, std::size_t count,
+                                  const StepObserver* observer, const BlockConsumer& consumer, unsigned worker) const {
+    const GbmParameters& params = walk.params;
+    const TimeGrid& grid = walk.grid;
+    const std::size_t steps = grid.steps.size();
+
+    // Advances `batch` paths through a step-major tile of unshifted normals,
+    // starting at simulated step `first`, and keeps the per-path sum of
+    // theta_j * z_j the likelihood ratio needs
+    auto advance = [&](std::size_t path, double* prices, const double* z, std::size_t batch, std::size_t first,
+                       std::size_t tile_steps, double* shifted_sums) {
+        for (std::size_t s = 0; s < tile_steps; ++s) {
+            const std::size_t j = first + s;
+            const double* z_step = z + s * batch;
+            if (walk.track_weights) {
+                for (std::size_t p = 0; p < batch; ++p) {
+                    shifted_sums[p] += walk.step_shift[j] * z_step[p];
+                }
+            }
+            {
+                QUANT_PHASE_SCOPE(Phase::Step);
+                step_kernel(prices, z_step, batch, walk.drift_dt[j], walk.vol_sqrt_dt[j]);
+            }
+            if (observer && grid.observed[j]) {
+                QUANT_PHASE_SCOPE(Phase::Payoff);
+                (*observer)(path, grid.steps[j], prices, batch, worker);
+            }
+        }
+    };
+
+    // Turns the shifted sums into dP/dQ weights in place
+    auto finish_weights = [&](double* shifted_sums, std::size_t batch) {
+        if (!walk.want_weights) {
+            return;
+        }
+        for (std::size_t p = 0; p < batch; ++p) {
+            shifted_sums[p] = walk.track_weights
+                            ? std::exp(-shifted_sums[p] - 0.5 * walk.theta * walk.theta * walk.fine_steps)
+                            : 1.0;
+        }
+    };
+
+    if (walk.quasi_random) {
+        std::vector<double> uniforms(kQmcBatch * steps);
+        std::vector<double> z(kQmcBatch * steps);
+        std::vector<double> normals(steps);
+        std::vector<double> increments(steps);
+        std::vector<double> prices(kQmcBatch);
+        std::vector<double> weights(kQmcBatch);
+
+        for (std::size_t offset = 0; offset < count; offset += kQmcBatch) {
+            const std::size_t batch = std::min(kQmcBatch, count - offset);
+            const std::size_t path = first_path + offset;
+            std::fill(prices.begin(), prices.end(), params.S0);
+            std::fill(weights.begin(), weights.end(), 0.0);
+
+            // One Sobol point per path: map to normals, build the path with the
+            // bridge, and store its increments step-major for the kernel
+            {
+                QUANT_PHASE_SCOPE(Phase::Rng);
+                walk.sobol->fill_points(path, batch, uniforms.data());
+                for (std::size_t p = 0; p < batch; ++p) {
+                    for (std::size_t d = 0; d < steps; ++d) {
+                        normals[d] = inverse_normal_cdf(uniforms[p * steps + d]);
+                    }
+                    walk.bridge->build_increments(normals.data(), increments.data());
+                    for (std::size_t s = 0; s < steps; ++s) {
+                        z[s * batch + p] = increments[s];
+                    }
+                }
+            }
+            advance(path, prices.data(), z.data(), batch, 0, steps, weights.data());
+            finish_weights(weights.data(), batch);
+            QUANT_PHASE_SCOPE(Phase::Payoff);
+            consumer(path, prices.data(), walk.want_weights ? weights.data() : nullptr, batch, worker);
+        }
+        return;
+    }
+
+    const PathNormalGenerator normals(config.seed, 0, config.isa);
+    std::vector<double> prices(count, params.S0);
+    std::vector<double> weights(count, 0.0);
+
+    // Antithetic paths 2k and 2k + 1 share the normals of source path k with opposite signs
+    const std::size_t num_sources = walk.antithetic ? (count + 1) / 2 : count;
+    std::vector<double> source(walk.antithetic ? kStepTile * num_sources : 0);
+
+    // Generate normals a tile of steps at a time, then advance the whole
+    // block one step at a time so the kernel sees contiguous lanes
+    std::vector<double> z(kStepTile * count);
+    for (std::size_t tile_start = 0; tile_start < steps; tile_start += kStepTile) {
+        const std::size_t tile_steps = std::min(kStepTile, steps - tile_start);
+        const std::uint32_t first_step = static_cast<std::uint32_t>(tile_start);
+        if (walk.antithetic) {
+            QUANT_PHASE_SCOPE(Phase::Rng);
+            normals.fill_block(first_path / 2, num_sources, first_step, tile_steps, source.data());
+            for (std::size_t s = 0; s < tile_steps; ++s) {
+                for (std::size_t k = 0; k < num_sources; ++k) {
+                    const double value = source[s * num_sources + k];
+                    z[s * count + 2 * k] = value;
+                    if (2 * k + 1 < count) {
+                        z[s * count + 2 * k + 1] = -value;
+                    }
+                }
+            }
+        } else {
+            QUANT_PHASE_SCOPE(Phase::Rng);
+            normals.fill_block(first_path, count, first_step, tile_steps, z.data());
+        }
+        advance(first_path, prices.data(), z.data(), count, tile_start, tile_steps, weights.data());
+    }
+    finish_weights(weights.data(), count);
+    QUANT_PHASE_SCOPE(Phase::Payoff);
+    consumer(first_path, prices.data(), walk.want_weights ? weights.data() : nullptr, count, worker);
+}
+
+void MonteCarloEngine::simulate_blocks(const GbmParameters& params, std::size_t first_path, std::size_t num_paths,
+                                       std::uint32_t replicate, bool want_weights, const TimeGrid& grid,
+                                       const StepObserver* observer, const BlockConsumer& consumer) {
+    const BlockWalk walk = make_walk(params, grid, replicate, want_weights);
+    const std::size_t block_size = config.block_size;
+    const std::size_t num_blocks = (num_paths + block_size - 1) / block_size;
+    pool.parallel_for(num_blocks, [&](std::size_t block, unsigned worker) {
+        const std::size_t begin = block * block_size;
+        walk_block(walk, first_path + begin, std::min(block_size, num_paths - begin), observer, consumer, worker);
+    });
+}
+
+std::vector<double> MonteCarloEngine::simulate_final_prices(const GbmParameters& params, std::size_t num_paths,
+                                                            std::uint32_t replicate,
+                                                            std::vector<double>* likelihood_ratios) {
+    std::vector<double> final_prices(num_paths);
+    if (likelihood_ratios) {
+        likelihood_ratios->assign(num_paths, 1.0);
+    }
+    simulate_blocks(params, 0, num_paths, replicate, likelihood_ratios != nullptr, terminal_grid(params), nullptr,
+                    [&](std::size_t first_path, const double* prices, const double* weights, std::size_t count,
+                        unsigned) {
+        std::copy(prices, prices + count, final_prices.begin() + first_path);
+        if (weights) {
+            std::copy(weights, weights + count, likelihood_ratios->begin() + first_path);
+        }
+    });
+    return final_prices;
+}
+
+PathStatistics MonteCarloEngine::simulate_statistics(const GbmParameters& params, std::size_t num_paths,
+                                                     const std::vector<double>& strikes, std::uint32_t replicate) {
+    // One accumulator per worker (or per block); each is only written by one worker at a time
+    PathStatistics empty;
+    empty.exceedances = ExceedanceCounter(strikes);
+    std::vector<PathStatistics> slots(reduction_slots(num_paths), empty);
+
+    simulate_blocks(params, 0, num_paths, replicate, false, terminal_grid(params), nullptr,
+                    [&](std::size_t first_path, const double* prices, const double*, std::size_t count,
+                        unsigned worker) {
+        PathStatistics& stats = slots[reduction_slot(first_path, worker)];
+        for (std::size_t i = 0; i < count; ++i) {
+            stats.add(prices[i]);
+        }
+    });
+    return merge_pairwise(slots);
+}
+
+void MonteCarloEngine::for_each_block(const GbmParameters& params, std::size_t num_paths,
+                                      const BlockConsumer& consumer, std::uint32_t replicate) {
+    simulate_blocks(params, 0, num_paths, replicate, true, terminal_grid(params), nullptr, consumer);
+}
+
+void MonteCarloEngine::for_each_observed_block(const GbmParameters& params, std::size_t num_paths,
+                                               const std::vector<std::size_t>& observation_steps,
+                                               const StepObserver& observer, const BlockConsumer& consumer,
+                                               std::uint32_t replicate) {
+    simulate_blocks(params, 0, num_paths, replicate, true, observation_grid(params, observation_steps), &observer,
+                    consumer);
+}
+
+void MonteCarloEngine::PayoffMoments::merge(const PayoffMoments& other) {
+    xy.merge(other.xy);
+    crude_sum += other.crude_sum;
+    crude_sum_sq += other.crude_sum_sq;
+    num_paths += other.num_paths;
+}
+
+MonteCarloEngine::PayoffMoments MonteCarloEngine::sample_payoff(const GbmParameters& params, std::size_t first_path,
+                                                                std::size_t num_paths, std::uint32_t replicate,
+                                                                const std::function<double(double)>& payoff) {
+    // Stream one sample per path (or per antithetic pair) into per-worker
+    // accumulators: y is the weighted payoff and x the weighted control, S_T,
+    // whose mean is known exactly
+    const bool antithetic = config.variance_reduction.antithetic && config.sampling != SamplingMode::QuasiRandom;
+    std::vector<PayoffMoments> slots(reduction_slots(num_paths));
+    simulate_blocks(params, first_path, num_paths, replicate, true, terminal_grid(params), nullptr,
+                    [&](std::size_t path, const double* prices, const double* weights, std::size_t count,
+                        unsigned worker) {
+        PayoffMoments& acc = slots[reduction_slot(path - first_path, worker)];
+        const std::size_t group = antithetic ? 2 : 1;
+        for (std::size_t i = 0; i < count; i += group) {
+            const std::size_t end = std::min(i + group, count);
+            double y_sum = 0.0, x_sum = 0.0;
+            for (std::size_t j = i; j < end; ++j) {
+                double value = payoff(prices[j]);
+                y_sum += weights[j] * value;
+                x_sum += weights[j] * prices[j];
+                acc.crude_sum += weights[j] * value;
+                acc.crude_sum_sq += weights[j] * value * value;
+            }
+            acc.xy.add(x_sum / (end - i), y_sum / (end - i));
+        }
+        acc.num_paths += count;
+    });
+    return merge_pairwise(slots);
+}
+
+Estimate MonteCarloEngine::combine_runs(const GbmParameters& params, const std::vector<PayoffMoments>& runs) const {
+    Estimate result;
+    const VarianceReduction& reduction = config.variance_reduction;
+    const bool quasi_random = config.sampling == SamplingMode::QuasiRandom;
+    const double expected_final_price = params.S0 * std::exp(params.mu * params.T);
+
+    PayoffMoments pooled;
+    for (const PayoffMoments& run : runs) {
+        pooled.merge(run);
+    }
+    if (pooled.num_paths == 0) {
+        return result;
+    }
+
+    // Control variate: y - beta * (x - E[x]) with the regression coefficient beta
+    double beta = 0.0;
+    if (reduction.control_variate && pooled.xy.variance_x() > 0.0) {
+        beta = pooled.xy.covariance() / pooled.xy.variance_x();
+    }
+
+    if (!quasi_random) {
+        // Independent samples: the error comes from the variance of the adjusted samples
+        const double n = static_cast<double>(pooled.xy.count());
+        double variance = pooled.xy.variance_y() - 2.0 * beta * pooled.xy.covariance()
+                        + beta * beta * pooled.xy.variance_x();
+        result.value = pooled.xy.mean_y() - beta * (pooled.xy.mean_x() - expected_final_price);
+        result.std_error = std::sqrt(std::max(variance, 0.0) / n);
+    } else {
+        // Randomized QMC: each replicate mean is an independent unbiased estimate
+        RunningStats replicate_means;
+        for (const PayoffMoments& run : runs) {
+            replicate_means.add(run.xy.mean_y() - beta * (run.xy.mean_x() - expected_final_price));
+        }
+        result.value = replicate_means.mean();
+        result.std_error = replicate_means.std_error();
+    }
+    result.num_paths = pooled.num_paths;
+
+    // Variance of plain Monte Carlo with the same number of paths, estimated
+    // from these paths (E_P[payoff^2] = E_Q[weight * payoff^2] under importance sampling)
+    const double n_paths = static_cast<double>(result.num_paths);
+    const double crude_mean = pooled.crude_sum / n_paths;
+    const double crude_variance = std::max(pooled.crude_sum_sq / n_paths - crude_mean * crude_mean, 0.0);
+    result.variance_reduction = (result.std_error > 0.0)
+        ? crude_variance / (n_paths * result.std_error * result.std_error) : 0.0;
+    return result;
+}
+
+Estimate MonteCarloEngine::estimate(const GbmParameters& params, std::size_t paths_per_replicate,
+                                    std::uint32_t replicates, const std::function<double(double)>& payoff) {
+    if (replicates == 0 || paths_per_replicate == 0) {
+        return Estimate();
+    }
+
+    // Pseudo-random paths are one big replicate; RQMC keeps replicates apart
+    const bool quasi_random = config.sampling == SamplingMode::QuasiRandom;
+    const std::uint32_t num_runs = quasi_random ? replicates : 1;
+    const std::size_t paths_per_run = quasi_random ? paths_per_replicate : paths_per_replicate * replicates;
+    std::vector<PayoffMoments> runs;
+    for (std::uint32_t r = 0; r < num_runs; ++r) {
+        runs.push_back(sample_payoff(params, 0, paths_per_run, r, payoff));
+    }
+    return combine_runs(params, runs);
+}
+
+AdaptiveEstimate MonteCarloEngine::estimate_to_target(const GbmParameters& params, const StoppingRule& rule,
+                                                      const std::function<double(double)>& payoff) {
+    AdaptiveEstimate result;
+    const bool quasi_random = config.sampling == SamplingMode::QuasiRandom;
+
+    // The tightest of the two targets, as a standard error
+    const double z = inverse_normal_cdf(0.5 + 0.5 * rule.confidence);
+    double target = std::numeric_limits<double>::infinity();
+    if (rule.target_std_error > 0.0) {
+        target = rule.target_std_error;
+    }
+    if (rule.target_ci_width > 0.0) {
+        target = std::min(target, rule.target_ci_width / (2.0 * z));
+    }
+
+    // Antithetic pairs must not straddle two batches
+    std::size_t batch_paths = std::max<std::size_t>(rule.batch_paths, 2);
+    batch_paths += batch_paths % 2;
+    const std::uint32_t min_batches = quasi_random ? 8 : 1;
+
+    std::vector<PayoffMoments> runs;
+    std::size_t next_batch = batch_paths;
+    for (;;) {
+        const std::size_t batch = std::min(next_batch, rule.max_paths - result.estimate.num_paths);
+        if (quasi_random) {
+            // Each batch is a fresh scrambling of the Sobol points
+            runs.push_back(sample_payoff(params, 0, batch, static_cast<std::uint32_t>(runs.size()), payoff));
+        } else {
+            // Each batch continues the path sequence and pools with the others
+            PayoffMoments moments = sample_payoff(params, result.estimate.num_paths, batch, 0, payoff);
+            if (runs.empty()) {
+                runs.push_back(moments);
+            } else {
+                runs[0].merge(moments);
+            }
+        }
+        ++result.batches;
+        result.estimate = combine_runs(params, runs);
+
+        const bool enough = result.batches >= min_batches;
+        result.target_met = enough && result.estimate.std_error <= target;
+        if (result.target_met || result.estimate.num_paths + (quasi_random ? batch_paths : 2) > rule.max_paths) {
+            break;
+        }
+
+        // Pseudo-random batches grow to the paths the current error predicts are
+        // still needed (error ~ 1 / sqrt(paths)), so hard targets take few rounds
+        if (!quasi_random && enough && result.estimate.std_error > 0.0) {
+            const double ratio = result.estimate.std_error / target;
+            const double needed = static_cast<double>(result.estimate.num_paths) * (ratio * ratio - 1.0);
+            const double capped = std::min(std::max(1.1 * needed, static_cast<double>(batch_paths)),
+                                           static_cast<double>(rule.max_paths));
+            next_batch = static_cast<std::size_t>(capped);
+            next_batch += next_batch % 2;
+        }
+    }
+    result.ci_half_width = z * result.estimate.std_error;
+    return result;
+}
+
+double importance_shift_for_strike(const GbmParameters& params, double strike) {
+    // Choose theta so that the median of S_T under the shifted measure is the strike
+    const double log_moneyness = std::log(strike / params.S0);
+    const double drift = (params.mu - 0.5 * params.sigma * params.sigma) * params.T;
+    return (log_moneyness - drift) / (params.sigma * std::sqrt(params.T * params.steps));
+}
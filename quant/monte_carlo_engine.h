@@ -0,0 +1,319 @@
+#ifndef MONTE_CARLO_ENGINE_H
+#define MONTE_CARLO_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gbm_kernel.h"
+#include "philox.h"
+#include "streaming_stats.h"
+#include "thread_pool.h"
+
+class BrownianBridge;
+class SobolSequence;
+
+// Parameters of a Geometric Brownian Motion price process
+struct GbmParameters {
+    double S0 = 100.0;      // Initial stock price
+    double mu = 0.05;       // Drift (expected annual return)
+    double sigma = 0.20;    // Volatility (annual standard deviation of returns)
+    double T = 1.0;         // Time horizon in years
+    int steps = 252;        // Number of time steps
+};
+
+// Where the engine's normal variates come from
+enum class SamplingMode {
+    PseudoRandom,   // Philox normals keyed by (seed, path, step)
+    QuasiRandom     // Scrambled Sobol points through a Brownian bridge
+};
+
+/**
+ * @brief Variance-reduction techniques the engine can switch on, alone or combined.
+ *
+ * Antithetic pairs apply to pseudo-random sampling only (scrambled Sobol
+ * points are already balanced). The control variate and importance sampling
+ * work in both sampling modes.
+ */
+struct VarianceReduction {
+    bool antithetic = false;        // Paths 2k and 2k + 1 use normals z and -z
+    bool control_variate = false;   // Regress the payoff on S_T, whose mean S0 * exp(mu * T) is known
+    double importance_shift = 0.0;  // Draw every normal from N(theta, 1) and reweight (0 = off)
+};
+
+// Settings that control how the engine spreads work across threads
+struct EngineConfig {
+    unsigned num_threads = 0;           // Worker threads (0 means one per hardware thread)
+    std::size_t block_size = 4096;      // Paths per work item
+    std::uint64_t seed = 0;             // Key of the counter-based generator
+    SimdIsa isa = detect_simd_isa();    // Step kernel (falls back to scalar if unsupported)
+    SamplingMode sampling = SamplingMode::PseudoRandom;
+    VarianceReduction variance_reduction;
+    bool exact_terminal = true;         // Sample S_T in one step when the payoff only needs S_T
+    bool reproducible = false;          // Reduce per block in a fixed order: same bits on any thread count
+};
+
+// A Monte Carlo estimate together with its standard error
+struct Estimate {
+    double value = 0.0;
+    double std_error = 0.0;
+    std::size_t num_paths = 0;
+    double variance_reduction = 1.0;    // Plain MC variance / this estimator's variance, at equal paths
+};
+
+// When an adaptive estimate may stop; the tighter of the two targets applies
+struct StoppingRule {
+    double target_std_error = 0.0;      // Standard error to reach (0 = unused)
+    double target_ci_width = 0.0;       // Full width of the confidence interval to reach (0 = unused)
+    double confidence = 0.95;           // Level of that interval
+    std::size_t batch_paths = 65536;    // Paths in the first batch (and in every RQMC replicate)
+    std::size_t max_paths = std::size_t(1) << 28;   // Budget: stop here even if the target is missed
+};
+
+// An estimate that stopped on its own accuracy
+struct AdaptiveEstimate {
+    Estimate estimate;              // num_paths is the paths used, std_error the achieved error
+    double ci_half_width = 0.0;     // Half-width of the confidence interval at the rule's level
+    std::size_t batches = 0;
+    bool target_met = false;        // False if max_paths ran out first
+};
+
+/**
+ * @brief Runs a single stock price simulation path using Geometric Brownian Motion.
+ *
+ * @param S0 Initial stock price.
+ * @param mu The drift (expected annual return).
+ * @param sigma The volatility (annual standard deviation of returns).
+ * @param T The time horizon in years.
+ * @param steps The number of time steps in the simulation.
+ * @param normals The counter-based normal generator keyed by the run's seed.
+ * @param path The index of the path to simulate; the same index always gives the same path.
+ * @return The final simulated stock price at the end of the time horizon.
+ */
+double run_single_simulation(double S0, double mu, double sigma, double T, int steps,
+                             const PathNormalGenerator& normals, std::uint64_t path);
+
+/**
+ * @brief Simulates many GBM paths in parallel on a thread pool.
+ *
+ * Paths are cut into fixed-size blocks. Every normal is addressed by
+ * (seed, path index, step) through a counter-based generator and each block
+ * writes only its own slice of the output, so workers never share an RNG or
+ * a result and the output is identical for any number of threads or block
+ * size. Within a block all paths advance together, one time step at a time,
+ * through the batched SIMD step kernel.
+ *
+ * Most entry points below only look at S_T, so with exact_terminal on the
+ * engine draws S_T from its lognormal law in a single step. Observers of
+ * intermediate steps make the engine stop at those steps as well.
+ *
+ * Paths are reproducible by construction, but by default each worker sums
+ * the blocks it happened to run, so the last bits of a mean depend on the
+ * schedule. In reproducible mode reductions keep one accumulator per block
+ * instead and merge them in a fixed pairwise tree over block indices; the
+ * result then depends only on the seed, the block size and the path count.
+ * Every pricer built on the engine reduces through reduction_slots() and
+ * merge_pairwise(), drivers with their own block size included.
+ */
+class MonteCarloEngine {
+public:
+    // Receives one finished block: prices (and dP/dQ weights if requested) of paths
+    // [first_path, first_path + count), on the worker that simulated it
+    using BlockConsumer = std::function<void(std::size_t first_path, const double* prices, const double* weights,
+                                             std::size_t count, unsigned worker)>;
+
+    // Receives the prices of paths [first_path, first_path + count) as soon as the
+    // simulation reaches time step `step` (1-based, in units of params.T / params.steps)
+    using StepObserver = std::function<void(std::size_t first_path, std::size_t step, const double* prices,
+                                            std::size_t count, unsigned worker)>;
+
+    explicit MonteCarloEngine(const EngineConfig& config);
+
+    /**
+     * @brief Simulates num_paths paths and returns their final prices in path order.
+     *
+     * In QuasiRandom mode, replicate selects an independent scrambling of the
+     * Sobol sequence; in PseudoRandom mode it is ignored. With importance
+     * sampling on, prices are drawn under the shifted measure and each must be
+     * weighted by its entry in likelihood_ratios (all 1 otherwise).
+     */
+    std::vector<double> simulate_final_prices(const GbmParameters& params, std::size_t num_paths,
+                                              std::uint32_t replicate = 0,
+                                              std::vector<double>* likelihood_ratios = nullptr);
+
+    /**
+     * @brief Simulates num_paths paths and summarizes their final prices in one pass.
+     *
+     * Nothing proportional to num_paths is kept: each worker feeds its own
+     * accumulator (moments, exceedance counts for strikes, quantile sketch)
+     * and the accumulators are merged at the end.
+     */
+    PathStatistics simulate_statistics(const GbmParameters& params, std::size_t num_paths,
+                                       const std::vector<double>& strikes, std::uint32_t replicate = 0);
+
+    /**
+     * @brief Estimates E[payoff(S_T)] with a standard error.
+     *
+     * PseudoRandom mode simulates paths_per_replicate * replicates i.i.d. paths.
+     * QuasiRandom mode runs `replicates` independently scrambled Sobol sets of
+     * paths_per_replicate points each (randomized QMC) and takes the error from
+     * the spread of the replicate means. Use a power of two for
+     * paths_per_replicate and at least 8 replicates. The configured variance
+     * reduction is applied and its achieved factor is reported in the result.
+     * Samples are streamed into per-worker accumulators, so memory does not
+     * grow with the number of paths.
+     */
+    Estimate estimate(const GbmParameters& params, std::size_t paths_per_replicate, std::uint32_t replicates,
+                      const std::function<double(double)>& payoff);
+
+    /**
+     * @brief Estimates E[payoff(S_T)] with as many paths as the stopping rule needs.
+     *
+     * Paths are simulated in batches, each spread over the workers like
+     * estimate(). After every batch the per-worker statistics are merged and
+     * the standard error checked against the target. Pseudo-random batches
+     * continue one path sequence, and after the first one they are sized from
+     * the error so far, so a hard target takes a few large batches rather than
+     * many small ones. QuasiRandom mode adds one scrambled replicate per batch
+     * and checks from the eighth on. Variance reduction applies as in estimate().
+     */
+    AdaptiveEstimate estimate_to_target(const GbmParameters& params, const StoppingRule& rule,
+                                        const std::function<double(double)>& payoff);
+
+    /**
+     * @brief Streams simulated final prices to consumer one block at a time.
+     *
+     * Runs on the worker threads; weights holds the likelihood ratios (all 1
+     * without importance sampling). The consumer must only write to state
+     * owned by its `worker` index, e.g. one accumulator per num_threads().
+     */
+    void for_each_block(const GbmParameters& params, std::size_t num_paths, const BlockConsumer& consumer,
+                        std::uint32_t replicate = 0);
+
+    /**
+     * @brief Streams paths chunk by chunk, showing observer their prices at chosen time steps.
+     *
+     * observation_steps lists 1-based steps (empty means every step). For each
+     * chunk of paths, observer is called at every observed step in increasing
+     * order and then consumer receives the chunk's prices at the last simulated
+     * step, all on the same worker. With exact_terminal on and a non-empty
+     * list, only the observed steps are simulated, each drawn exactly from its
+     * lognormal law given the one before; otherwise every step up to the last
+     * observation is walked.
+     */
+    void for_each_observed_block(const GbmParameters& params, std::size_t num_paths,
+                                 const std::vector<std::size_t>& observation_steps, const StepObserver& observer,
+                                 const BlockConsumer& consumer, std::uint32_t replicate = 0);
+
+    unsigned num_threads() const;
+    SimdIsa isa() const;
+    std::uint64_t seed() const;
+    std::size_t block_size() const;
+    bool reproducible() const;
+    SamplingMode sampling() const;
+    const VarianceReduction& variance_reduction() const;
+    bool exact_terminal() const;
+
+    // Accumulators a reduction over num_paths paths should keep: one per
+    // worker, or one per block in reproducible mode
+    std::size_t reduction_slots(std::size_t num_paths) const;
+
+    // Accumulator for the block starting path_offset paths into the run, on worker;
+    // merge the slots with merge_pairwise() so the order is fixed
+    std::size_t reduction_slot(std::size_t path_offset, unsigned worker) const;
+
+    // The same for drivers that split a run into their own blocks of block_size paths
+    std::size_t reduction_slots(std::size_t num_paths, std::size_t block_size) const;
+    std::size_t reduction_slot(std::size_t path_offset, unsigned worker, std::size_t block_size) const;
+
+    // The engine's workers, for drivers that schedule their own per-path work
+    ThreadPool& thread_pool();
+
+    // One run's grid and per-step constants, prepared once and walked block by block
+    struct BlockWalk;
+
+    /**
+     * @brief Prepares a run for drivers that schedule its blocks from their own tasks.
+     *
+     * Takes the same arguments as for_each_observed_block. Walking paths
+     * [b * block_size(), ...) with walk_block() then simulates block b of that
+     * call exactly: same normals, antithetic pairs, Sobol points and
+     * importance weights. price_book uses it to put the blocks of a whole
+     * book on the pool as one set of tasks.
+     */
+    BlockWalk prepare_walk(const GbmParameters& params, const std::vector<std::size_t>& observation_steps,
+                           std::uint32_t replicate = 0) const;
+
+    // Simulates paths [first_path, first_path + count) of a prepared run on the
+    // calling thread. With antithetic pairs first_path must be even.
+    void walk_block(const BlockWalk& walk, std::size_t first_path, std::size_t count, const StepObserver* observer,
+                    const BlockConsumer& consumer, unsigned worker) const;
+
+private:
+    // The time steps a simulation visits: steps[j] is the 1-based fine step
+    // reached after simulated step j, and observed[j] whether it is reported
+    struct TimeGrid {
+        std::vector<std::size_t> steps;
+        std::vector<char> observed;
+    };
+
+    // Only S_T is needed: one exact step, or every step without exact_terminal
+    TimeGrid terminal_grid(const GbmParameters& params) const;
+    TimeGrid observation_grid(const GbmParameters& params, std::vector<std::size_t> observation_steps) const;
+
+    // prepare_walk() over an explicit grid
+    BlockWalk make_walk(const GbmParameters& params, const TimeGrid& grid, std::uint32_t replicate,
+                        bool want_weights) const;
+
+    // Simulates paths [first_path, first_path + num_paths) block by block over
+    // grid, calls observer at the observed steps and hands each finished chunk
+    // to consumer. With antithetic pairs first_path must be even.
+    void simulate_blocks(const GbmParameters& params, std::size_t first_path, std::size_t num_paths,
+                         std::uint32_t replicate, bool want_weights, const TimeGrid& grid,
+                         const StepObserver* observer, const BlockConsumer& consumer);
+
+    // Sums behind estimate(): y is the weighted payoff and x the weighted
+    // control S_T, one sample per path (or per antithetic pair)
+    struct PayoffMoments {
+        RunningCovariance xy;
+        double crude_sum = 0.0;
+        double crude_sum_sq = 0.0;
+        std::size_t num_paths = 0;
+
+        void merge(const PayoffMoments& other);
+    };
+
+    // Samples paths [first_path, first_path + num_paths) of a replicate on the workers
+    PayoffMoments sample_payoff(const GbmParameters& params, std::size_t first_path, std::size_t num_paths,
+                                std::uint32_t replicate, const std::function<double(double)>& payoff);
+
+    // Pooled pseudo-random runs, or independent RQMC replicates, into one estimate
+    Estimate combine_runs(const GbmParameters& params, const std::vector<PayoffMoments>& runs) const;
+
+    EngineConfig config;
+    ThreadPool pool;
+    GbmStepKernel step_kernel;
+};
+
+struct MonteCarloEngine::BlockWalk {
+    GbmParameters params;
+    TimeGrid grid;
+    bool quasi_random = false;
+    bool antithetic = false;
+    bool want_weights = true;
+    bool track_weights = false;             // Importance sampling on: weights are not all 1
+    double theta = 0.0;                     // Importance shift per fine step
+    double fine_steps = 0.0;
+    std::vector<double> drift_dt;           // Per simulated step, shift included
+    std::vector<double> vol_sqrt_dt;
+    std::vector<double> step_shift;
+    std::shared_ptr<const SobolSequence> sobol;     // Quasi-random sampling only
+    std::shared_ptr<const BrownianBridge> bridge;
+};
+
+// Importance-sampling shift that centres the terminal price distribution on strike
+double importance_shift_for_strike(const GbmParameters& params, double strike);
+
+#endif // MONTE_CARLO_ENGINE_H
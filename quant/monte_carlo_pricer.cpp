@@ -5,41 +5,34 @@
 
 #include <iostream>
 #include <vector>
-#include <random>
+#include <cstdint>
 #include <cmath>
-#include <numeric>      // For std::accumulate
-#include <algorithm>    // For std::min_element and std::max_element
 #include <iomanip>      // For std::fixed and std::setprecision
+#include <chrono>       // For timing the simulation run
+#include <functional>   // For std::function
+#include <algorithm>    // For std::max
+#include <filesystem>   // For the path store's temporary file
+#include <string>
 
-/**
- * @brief Runs a single stock price simulation path using Geometric Brownian Motion.
- * 
- * @param S0 Initial stock price.
- * @param mu The drift (expected annual return).
- * @param sigma The volatility (annual standard deviation of returns).
- * @param T The time horizon in years.
- * @param steps The number of time steps in the simulation.
- * @param generator A reference to the random number generator.
- * @param distribution A reference to the normal distribution.
- * @return The final simulated stock price at the end of the time horizon.
- */
-double run_single_simulation(double S0, double mu, double sigma, double T, int steps, 
-                             std::mt19937& generator, std::normal_distribution<>& distribution) {
-    
-    double dt = T / steps; // The size of a single time step
-    double price = S0;
-
-    for (int i = 0; i < steps; ++i) {
-        // Generate a random number from the standard normal distribution (Z)
-        double Z = distribution(generator);
-        
-        // Apply the Geometric Brownian Motion formula
-        // S_t = S_{t-1} * exp( (mu - 0.5 * sigma^2) * dt + sigma * Z * sqrt(dt) )
-        price *= std::exp((mu - 0.5 * sigma * sigma) * dt + sigma * Z * std::sqrt(dt));
-    }
-
-    return price;
-}
+#include <unistd.h>     // For getpid, naming the path store's file
+
+#include "aad_greeks.h"
+#include "american_option.h"
+#include "basket.h"
+#include "book_pricer.h"
+#include "european_option.h"
+#include "gbm_path_engine.h"
+#include "heston.h"
+#include "instrumentation.h"
+#include "merton.h"
+#include "mlmc.h"
+#include "monte_carlo_engine.h"
+#include "normal_math.h"
+#include "option_chain.h"
+#include "path_store.h"
+#include "path_payoffs.h"
+#include "process_simulator.h"
+#include "risk.h"
 
 int main() {
     // --- 1. DEFINE SIMULATION PARAMETERS ---
@@ -49,6 +42,8 @@ int main() {
     double T = 1.0;                 // Time horizon in years (1 year)
     int num_simulations = 10000;    // Number of Monte Carlo simulations to run
     int steps = 252;                // Number of time steps (e.g., trading days in a year)
+    unsigned num_threads = 0;       // Worker threads (0 = one per hardware thread)
+    std::uint64_t seed = 20240101;  // Fixed seed so every run is reproducible
 
     std::cout << "--- Monte Carlo Stock Price Simulator ---" << std::endl;
     std::cout << "Running " << num_simulations << " simulations..." << std::endl;
@@ -60,55 +55,778 @@ int main() {
     std::cout << "-----------------------------------------" << std::endl;
 
 
-    // --- 2. SETUP RANDOM NUMBER GENERATION ---
-    // Use the Mersenne Twister engine for high-quality random numbers
-    std::mt19937 generator(std::random_device{}()); 
-    // Standard normal distribution (mean=0.0, stddev=1.0)
-    std::normal_distribution<> distribution(0.0, 1.0);
+    // --- 2. SETUP THE PARALLEL SIMULATION ENGINE ---
+    // Every normal comes from a Philox counter keyed by (seed, path index, step)
+    EngineConfig config;
+    config.num_threads = num_threads;
+    config.seed = seed;
+    MonteCarloEngine engine(config);
+
+    GbmParameters params;
+    params.S0 = S0;
+    params.mu = mu;
+    params.sigma = sigma;
+    params.T = T;
+    params.steps = steps;
 
 
     // --- 3. RUN THE SIMULATIONS ---
-    std::vector<double> final_prices;
-    final_prices.reserve(num_simulations); // Pre-allocate memory for efficiency
+    // Terminal prices are summarized on the fly; no per-path vector is kept
+    double strike_price = 110.0;
+    std::vector<double> report_strikes = {90.0, 100.0, strike_price, 120.0, 130.0};
+    auto start_time = std::chrono::steady_clock::now();
+    PathStatistics stats = engine.simulate_statistics(params, num_simulations, report_strikes);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+
+
+    // --- 4. DISPLAY THE RESULTS ---
+    std::cout << "--- Simulation Results ---" << std::endl;
+    std::cout << "Simulated on " << engine.num_threads() << " thread(s) with the "
+              << simd_isa_name(engine.isa()) << " kernel in "
+              << std::fixed << std::setprecision(3) << elapsed.count() << " s" << std::endl;
+    std::cout << "Average Simulated Final Price: $" << std::fixed << std::setprecision(2) << stats.moments.mean()
+              << " (+/- " << stats.moments.std_error() << ")" << std::endl;
+    std::cout << "Minimum Simulated Final Price: $" << std::fixed << std::setprecision(2) << stats.moments.min() << std::endl;
+    std::cout << "Maximum Simulated Final Price: $" << std::fixed << std::setprecision(2) << stats.moments.max() << std::endl;
+    std::cout << "5% / 50% / 95% Quantiles:      $" << stats.quantiles.quantile(0.05)
+              << " / $" << stats.quantiles.quantile(0.50) << " / $" << stats.quantiles.quantile(0.95) << std::endl;
 
-    for (int i = 0; i < num_simulations; ++i) {
-        double final_price = run_single_simulation(S0, mu, sigma, T, steps, generator, distribution);
-        final_prices.push_back(final_price);
+    // Only S_T matters here, so the engine sampled it exactly in one step.
+    // Walking all the steps gives the same distribution at a much higher cost.
+    EngineConfig stepped_config = config;
+    stepped_config.exact_terminal = false;
+    MonteCarloEngine stepped_engine(stepped_config);
+    auto stepped_start = std::chrono::steady_clock::now();
+    PathStatistics stepped_stats = stepped_engine.simulate_statistics(params, num_simulations, report_strikes);
+    std::chrono::duration<double> stepped_elapsed = std::chrono::steady_clock::now() - stepped_start;
+    std::cout << "Full " << steps << "-step walk:            $" << stepped_stats.moments.mean() << " average in "
+              << std::setprecision(3) << stepped_elapsed.count() << " s ("
+              << std::setprecision(0) << stepped_elapsed.count() / elapsed.count() << "x slower)" << std::endl;
+
+    // Any stepped path can be regenerated on its own from its index
+    PathNormalGenerator normals(seed);
+    double replayed_price = run_single_simulation(S0, mu, sigma, T, steps, normals, 0);
+    std::cout << "First Path Replayed Alone:     $" << std::fixed << std::setprecision(2) << replayed_price
+              << " (engine: $" << stepped_engine.simulate_final_prices(params, 1)[0] << ")" << std::endl;
+    std::cout << "--------------------------" << std::endl;
+
+
+    // --- 5. BASIC OPTION PRICING EXAMPLE ---
+    // The probability of the stock price ending above each strike comes from the same single pass
+    std::cout << "--- Basic Option Pricing Example ---" << std::endl;
+    for (std::size_t k = 0; k < report_strikes.size(); ++k) {
+        std::cout << "Probability of price > $" << std::setprecision(2) << report_strikes[k] << ": "
+                  << std::fixed << std::setprecision(2) << stats.exceedances.probability_above(k) * 100.0 << "%" << std::endl;
     }
+    std::cout << "------------------------------------" << std::endl;
 
 
-    // --- 4. ANALYZE THE RESULTS ---
-    // Calculate the average of all simulated final prices
-    double sum_of_prices = std::accumulate(final_prices.begin(), final_prices.end(), 0.0);
-    double average_price = sum_of_prices / num_simulations;
+    // --- 6. QUASI-MONTE CARLO COMPARISON ---
+    // Same path budget: i.i.d. Philox paths vs 16 scrambled Sobol replicates with a Brownian bridge
+    std::uint32_t replicates = 16;
+    std::size_t paths_per_replicate = 1024;
+    auto above_strike = [strike_price](double price) { return price > strike_price ? 1.0 : 0.0; };
 
-    // Find the minimum and maximum simulated prices
-    double min_price = *std::min_element(final_prices.begin(), final_prices.end());
-    double max_price = *std::max_element(final_prices.begin(), final_prices.end());
+    EngineConfig qmc_config = config;
+    qmc_config.sampling = SamplingMode::QuasiRandom;
+    MonteCarloEngine qmc_engine(qmc_config);
 
+    std::cout << "--- Quasi-Monte Carlo Comparison (" << replicates * paths_per_replicate << " paths each) ---" << std::endl;
+    auto compare = [&](const char* label, const std::function<double(double)>& payoff, double unit) {
+        Estimate mc_estimate = engine.estimate(params, paths_per_replicate, replicates, payoff);
+        Estimate qmc_estimate = qmc_engine.estimate(params, paths_per_replicate, replicates, payoff);
+        std::cout << label << std::endl;
+        std::cout << "  Monte Carlo:    " << std::fixed << std::setprecision(4) << mc_estimate.value * unit
+                  << " +/- " << mc_estimate.std_error * unit << std::endl;
+        std::cout << "  Sobol + Bridge: " << qmc_estimate.value * unit
+                  << " +/- " << qmc_estimate.std_error * unit << std::endl;
+        // Beyond ~1e6 the Sobol error is rounding noise, not sampling error
+        double variance_ratio = (mc_estimate.std_error * mc_estimate.std_error)
+                              / (qmc_estimate.std_error * qmc_estimate.std_error);
+        if (variance_ratio > 1e6) {
+            std::cout << "  Variance reduction: > 1000000x (exact up to rounding)" << std::endl;
+        } else {
+            std::cout << "  Variance reduction: " << std::setprecision(1) << variance_ratio
+                      << "x (paths saved at equal error)" << std::endl;
+        }
+    };
+    compare("Average final price ($):", [](double price) { return price; }, 1.0);
+    compare("Probability of price > strike (%):", above_strike, 100.0);
+    std::cout << "------------------------------------" << std::endl;
 
-    // --- 5. DISPLAY THE RESULTS ---
-    std::cout << "--- Simulation Results ---" << std::endl;
-    std::cout << "Average Simulated Final Price: $" << std::fixed << std::setprecision(2) << average_price << std::endl;
-    std::cout << "Minimum Simulated Final Price: $" << std::fixed << std::setprecision(2) << min_price << std::endl;
-    std::cout << "Maximum Simulated Final Price: $" << std::fixed << std::setprecision(2) << max_price << std::endl;
-    std::cout << "--------------------------" << std::endl;
 
-    // A simple example of how this can be used for option pricing:
-    // Calculate the probability of the stock price ending above a certain strike price
-    double strike_price = 110.0;
-    int count_above_strike = 0;
-    for (double price : final_prices) {
-        if (price > strike_price) {
-            count_above_strike++;
+    // --- 7. VARIANCE REDUCTION ---
+    // Each technique on its own and all combined, for the example strike and a deep out-of-the-money one
+    struct Technique {
+        const char* name;
+        bool antithetic;
+        bool control_variate;
+        bool importance_sampling;
+    };
+    const Technique techniques[] = {
+        {"Plain Monte Carlo", false, false, false},
+        {"Antithetic pairs", true, false, false},
+        {"Control variate (S_T)", false, true, false},
+        {"Importance sampling", false, false, true},
+        {"All combined", true, true, true},
+    };
+    const double deep_otm_strike = 150.0;
+
+    std::cout << "--- Variance Reduction (" << replicates * paths_per_replicate << " paths each) ---" << std::endl;
+    for (double strike : {strike_price, deep_otm_strike}) {
+        auto exceeds = [strike](double price) { return price > strike ? 1.0 : 0.0; };
+        std::cout << "Probability of price > $" << std::setprecision(2) << strike << ":" << std::endl;
+        for (const Technique& technique : techniques) {
+            EngineConfig vr_config = config;
+            vr_config.variance_reduction.antithetic = technique.antithetic;
+            vr_config.variance_reduction.control_variate = technique.control_variate;
+            vr_config.variance_reduction.importance_shift =
+                technique.importance_sampling ? importance_shift_for_strike(params, strike) : 0.0;
+            MonteCarloEngine vr_engine(vr_config);
+            Estimate result = vr_engine.estimate(params, paths_per_replicate, replicates, exceeds);
+            std::cout << "  " << std::left << std::setw(24) << technique.name << std::right
+                      << std::setprecision(4) << std::setw(8) << result.value * 100.0 << "% +/- "
+                      << std::setw(7) << result.std_error * 100.0 << "%   VRF "
+                      << std::setprecision(1) << result.variance_reduction << "x" << std::endl;
         }
     }
-    double probability_above_strike = static_cast<double>(count_above_strike) / num_simulations;
+    std::cout << "------------------------------------" << std::endl;
 
-    std::cout << "--- Basic Option Pricing Example ---" << std::endl;
-    std::cout << "Probability of price > $" << strike_price << ": " 
-              << std::fixed << std::setprecision(2) << probability_above_strike * 100.0 << "%" << std::endl;
+
+    // --- 8. EUROPEAN OPTION PRICES AND GREEKS ---
+    // Risk-neutral pricing: the drift is the risk-free rate. All Greeks come from the same paths.
+    double risk_free_rate = 0.05;
+    std::size_t pricing_paths = 200000;
+    GbmParameters risk_neutral = params;
+    risk_neutral.mu = risk_free_rate;
+
+    std::cout << "--- European Options (K = $" << std::setprecision(2) << strike_price << ", r = "
+              << risk_free_rate * 100.0 << "%, " << pricing_paths << " paths) ---" << std::endl;
+    for (OptionType type : {OptionType::Call, OptionType::Put}) {
+        EuropeanOptionResult pathwise = price_european_option(engine, risk_neutral, type, strike_price, pricing_paths,
+                                                              GreekEstimator::Pathwise);
+        EuropeanOptionResult likelihood = price_european_option(engine, risk_neutral, type, strike_price, pricing_paths,
+                                                                GreekEstimator::LikelihoodRatio);
+        OptionGreeks exact = black_scholes(type, S0, strike_price, risk_free_rate, sigma, T);
+
+        std::cout << std::left << std::setw(10) << (type == OptionType::Call ? "Call" : "Put") << std::right
+                  << std::setw(22) << "Pathwise" << std::setw(22) << "Likelihood Ratio"
+                  << std::setw(14) << "Black-Scholes" << std::endl;
+        auto row = [](const char* name, const Estimate& pw, const Estimate& lr, double closed_form) {
+            std::cout << "  " << std::left << std::setw(8) << name << std::right << std::setprecision(4)
+                      << std::setw(11) << pw.value << " +/- " << std::setw(6) << pw.std_error
+                      << std::setw(11) << lr.value << " +/- " << std::setw(6) << lr.std_error
+                      << std::setw(14) << closed_form << std::endl;
+        };
+        row("Price", pathwise.price, likelihood.price, exact.price);
+        row("Delta", pathwise.delta, likelihood.delta, exact.delta);
+        row("Gamma", pathwise.gamma, likelihood.gamma, exact.gamma);
+        row("Vega", pathwise.vega, likelihood.vega, exact.vega);
+        row("Rho", pathwise.rho, likelihood.rho, exact.rho);
+    }
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 9. ADJOINT (AAD) SENSITIVITIES ---
+    // Every sensitivity, including one vega per quarterly volatility bucket, from one
+    // block-wide reverse sweep per tile of paths over the full 252-step walk
+    std::size_t aad_paths = 20000;
+    std::vector<double> quarterly_vols(4, sigma);
+    auto aad_start = std::chrono::steady_clock::now();
+    AadGreeksResult aad = price_european_aad(engine, risk_neutral, OptionType::Call, strike_price, aad_paths,
+                                             quarterly_vols);
+    std::chrono::duration<double> aad_elapsed = std::chrono::steady_clock::now() - aad_start;
+
+    auto pricing_start = std::chrono::steady_clock::now();
+    stepped_engine.estimate(risk_neutral, aad_paths, 1, [&](double S_T) {
+        return (S_T > strike_price) ? S_T - strike_price : 0.0;
+    });
+    std::chrono::duration<double> pricing_elapsed = std::chrono::steady_clock::now() - pricing_start;
+
+    OptionGreeks call_exact = black_scholes(OptionType::Call, S0, strike_price, risk_free_rate, sigma, T);
+    std::cout << "--- AAD Greeks (Call, " << aad_paths << " paths, " << steps << " steps) ---" << std::endl;
+    std::cout << std::setw(32) << "AAD" << std::setw(14) << "Black-Scholes" << std::endl;
+    auto aad_row = [](const char* name, const Estimate& estimate, double closed_form) {
+        std::cout << "  " << std::left << std::setw(8) << name << std::right << std::setprecision(4)
+                  << std::setw(11) << estimate.value << " +/- " << std::setw(6) << estimate.std_error
+                  << std::setw(14) << closed_form << std::endl;
+    };
+    aad_row("Price", aad.price, call_exact.price);
+    aad_row("Delta", aad.delta, call_exact.delta);
+    aad_row("Vega", aad.vega, call_exact.vega);
+    aad_row("Rho", aad.rho, call_exact.rho);
+    for (std::size_t k = 0; k < aad.bucket_vegas.size(); ++k) {
+        std::cout << "  Vega Q" << k + 1 << "  " << std::setw(11) << aad.bucket_vegas[k].value << " +/- "
+                  << std::setw(6) << aad.bucket_vegas[k].std_error << std::endl;
+    }
+    std::cout << "AAD time: " << std::setprecision(3) << aad_elapsed.count() << " s ("
+              << std::setprecision(1) << aad_elapsed.count() / pricing_elapsed.count()
+              << "x one stepped pricing pass)" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 10. OPTION CHAIN FROM ONE SIMULATION ---
+    // Every strike and maturity is priced from the same paths, snapshotted at each maturity
+    OptionChain chain;
+    chain.strikes = {80.0, 90.0, 100.0, 110.0, 120.0, 130.0};
+    chain.maturities = {0.25, 0.5, 0.75, 1.0};
+    auto chain_start = std::chrono::steady_clock::now();
+    PriceSurface surface = price_option_chain(engine, risk_neutral, chain, pricing_paths);
+    std::chrono::duration<double> chain_elapsed = std::chrono::steady_clock::now() - chain_start;
+
+    // The same options priced one simulation at a time, for comparison
+    auto separate_start = std::chrono::steady_clock::now();
+    for (double maturity : chain.maturities) {
+        GbmParameters expiry = risk_neutral;
+        expiry.T = maturity;
+        for (double strike : chain.strikes) {
+            engine.estimate(expiry, pricing_paths, 1, [&](double S_T) {
+                return (S_T > strike) ? S_T - strike : 0.0;
+            });
+        }
+    }
+    std::chrono::duration<double> separate_elapsed = std::chrono::steady_clock::now() - separate_start;
+
+    std::cout << "--- Call Surface (" << pricing_paths << " shared paths; Black-Scholes in brackets) ---" << std::endl;
+    std::cout << std::setw(8) << "T \\ K";
+    for (double strike : surface.strikes) {
+        std::cout << std::setw(18) << std::setprecision(0) << strike;
+    }
+    std::cout << std::endl;
+    double worst_z = 0.0;
+    for (std::size_t m = 0; m < surface.maturities.size(); ++m) {
+        std::cout << std::setw(8) << std::setprecision(2) << surface.maturities[m];
+        for (std::size_t k = 0; k < surface.strikes.size(); ++k) {
+            double exact_call = black_scholes(OptionType::Call, S0, surface.strikes[k], risk_free_rate, sigma,
+                                              surface.maturities[m]).price;
+            double exact_put = black_scholes(OptionType::Put, S0, surface.strikes[k], risk_free_rate, sigma,
+                                             surface.maturities[m]).price;
+            const Estimate& call = surface.call(m, k);
+            const Estimate& put = surface.put(m, k);
+            worst_z = std::max(worst_z, std::fabs(call.value - exact_call) / call.std_error);
+            worst_z = std::max(worst_z, std::fabs(put.value - exact_put) / put.std_error);
+            std::cout << std::setw(9) << std::setprecision(3) << call.value << " [" << std::setw(6) << exact_call
+                      << "]";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "Largest |MC - Black-Scholes| over calls and puts: " << std::setprecision(2) << worst_z
+              << " standard errors" << std::endl;
+    std::cout << surface.calls.size() << " calls and " << surface.puts.size() << " puts in "
+              << std::setprecision(3) << chain_elapsed.count() << " s (" << std::setprecision(1)
+              << separate_elapsed.count() / chain_elapsed.count() << "x faster than one simulation per call)"
+              << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 11. PATH-DEPENDENT OPTIONS ---
+    // Each path carries only a running sum, a barrier flag or a running extreme
+    std::size_t exotic_paths = 100000;
+    double at_the_money = S0;
+    double down_barrier = 90.0;
+    struct ExoticCase {
+        const char* name;
+        const PathPayoff* payoff;
+        double reference;   // Closed form, or a negative value when there is none
+    };
+    AsianOption arithmetic_asian(OptionType::Call, at_the_money, Averaging::Arithmetic);
+    AsianOption geometric_asian(OptionType::Call, at_the_money, Averaging::Geometric);
+    BarrierOption down_and_out(OptionType::Call, at_the_money, down_barrier, BarrierType::DownAndOut);
+    BarrierOption down_and_in(OptionType::Call, at_the_money, down_barrier, BarrierType::DownAndIn);
+    LookbackOption lookback_call(OptionType::Call);
+    LookbackOption lookback_put(OptionType::Put);
+    double knock_out_reference = discrete_down_and_out_call(S0, at_the_money, down_barrier, risk_free_rate, sigma,
+                                                            T, steps);
+    std::vector<ExoticCase> exotics = {
+        {"Arithmetic Asian call", &arithmetic_asian, -1.0},
+        {"Geometric Asian call", &geometric_asian,
+         geometric_asian_price(OptionType::Call, S0, at_the_money, risk_free_rate, sigma, T, steps)},
+        {"Down-and-out call (90)", &down_and_out, knock_out_reference},
+        {"Down-and-in call (90)", &down_and_in,
+         black_scholes(OptionType::Call, S0, at_the_money, risk_free_rate, sigma, T).price - knock_out_reference},
+        {"Lookback call", &lookback_call, -1.0},
+        {"Lookback put", &lookback_put, -1.0},
+    };
+
+    std::cout << "--- Path-Dependent Options (K = $" << std::setprecision(2) << at_the_money << ", "
+              << exotic_paths << " paths x " << steps << " steps) ---" << std::endl;
+    std::cout << std::left << std::setw(24) << "Option" << std::right << std::setw(22) << "Monte Carlo"
+              << std::setw(14) << "Closed form" << std::endl;
+    for (const ExoticCase& exotic : exotics) {
+        Estimate price = price_path_dependent(engine, risk_neutral, *exotic.payoff, exotic_paths);
+        std::cout << std::left << std::setw(24) << exotic.name << std::right << std::setprecision(4)
+                  << std::setw(11) << price.value << " +/- " << std::setw(6) << price.std_error;
+        if (exotic.reference >= 0.0) {
+            std::cout << std::setw(14) << exotic.reference;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 12. AMERICAN PUT (LONGSTAFF-SCHWARTZ) ---
+    // The test case of Longstaff & Schwartz (2001): S0 = 36, K = 40, r = 6%, sigma = 20%,
+    // T = 1, 50 exercise dates; their finite-difference value is 4.478
+    GbmParameters ls_params;
+    ls_params.S0 = 36.0;
+    ls_params.mu = 0.06;
+    ls_params.sigma = 0.20;
+    ls_params.T = 1.0;
+    ls_params.steps = 50;
+    double ls_strike = 40.0;
+    std::size_t ls_paths = 200000;
+
+    std::cout << "--- American Put (S0 = $36, K = $40, 50 exercise dates, " << ls_paths << " paths) ---"
+              << std::endl;
+    for (bool single_precision : {false, true}) {
+        LsmConfig lsm;
+        lsm.exercise_dates = 50;
+        lsm.single_precision = single_precision;
+        auto lsm_start = std::chrono::steady_clock::now();
+        AmericanOptionResult american = price_american_option(engine, ls_params, OptionType::Put, ls_strike,
+                                                              ls_paths, lsm);
+        std::chrono::duration<double> lsm_elapsed = std::chrono::steady_clock::now() - lsm_start;
+        std::cout << (single_precision ? "float32 paths: " : "float64 paths: ") << std::setprecision(4) << "$"
+                  << american.price.value << " +/- " << american.price.std_error
+                  << " (early exercise premium $" << american.early_exercise_premium << ", "
+                  << std::setprecision(1) << american.storage_bytes / 1048576.0 << " MB, "
+                  << std::setprecision(3) << lsm_elapsed.count() << " s)" << std::endl;
+    }
+    std::cout << "Finite-difference reference: $4.4780 (Longstaff-Schwartz in the paper: $4.4720)" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 13. HESTON STOCHASTIC VOLATILITY ---
+    // Same block and thread machinery, with the model's step loop chosen at compile time
+    HestonParameters heston;
+    heston.S0 = S0;
+    heston.r = risk_free_rate;
+    std::vector<double> process_strikes = {90.0, 100.0, 110.0};
+    std::size_t process_paths = 100000;
+    int process_steps = 100;
+
+    // One set of reduction slots per strike, merged pairwise, so the prices honour reproducible mode
+    auto simulate_calls = [&](const auto& simulator, double& seconds) {
+        std::vector<std::vector<RunningStats>> slots(
+            process_strikes.size(), std::vector<RunningStats>(simulator.reduction_slots(process_paths)));
+        auto process_start = std::chrono::steady_clock::now();
+        simulator.for_each_block(T, process_steps, process_paths, [&](std::size_t first_path, const double* prices,
+                                                                     const double*, std::size_t count,
+                                                                     unsigned worker) {
+            const std::size_t slot = simulator.reduction_slot(first_path, worker);
+            for (std::size_t k = 0; k < process_strikes.size(); ++k) {
+                RunningStats& stats = slots[k][slot];
+                for (std::size_t i = 0; i < count; ++i) {
+                    stats.add(std::exp(-risk_free_rate * T) * std::max(prices[i] - process_strikes[k], 0.0));
+                }
+            }
+        });
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - process_start).count();
+        std::vector<RunningStats> totals;
+        for (std::vector<RunningStats>& strike_slots : slots) {
+            totals.push_back(merge_pairwise(strike_slots));
+        }
+        return totals;
+    };
+    double heston_seconds = 0.0, gbm_seconds = 0.0;
+    std::vector<RunningStats> heston_calls = simulate_calls(
+        ProcessSimulator<HestonProcess>(HestonProcess(heston), engine), heston_seconds);
+    std::vector<RunningStats> gbm_calls = simulate_calls(
+        ProcessSimulator<GbmProcess>(GbmProcess(S0, risk_free_rate, sigma, engine.isa()), engine), gbm_seconds);
+
+    std::cout << "--- Heston Calls (QE scheme, " << process_paths << " paths x " << process_steps << " steps) ---"
+              << std::endl;
+    std::cout << std::setprecision(2) << "v0 = " << heston.v0 << ", kappa = " << heston.kappa << ", theta = "
+              << heston.theta << ", xi = " << heston.xi << ", rho = " << heston.rho << std::endl;
+    std::cout << std::left << std::setw(10) << "Strike" << std::right << std::setw(22) << "Heston MC"
+              << std::setw(14) << "Semi-analytic" << std::setw(22) << "GBM MC" << std::setw(14) << "Black-Scholes"
+              << std::endl;
+    for (std::size_t k = 0; k < process_strikes.size(); ++k) {
+        std::cout << std::left << std::setw(10) << std::setprecision(0) << process_strikes[k] << std::right
+                  << std::setprecision(4) << std::setw(11) << heston_calls[k].mean() << " +/- " << std::setw(6)
+                  << heston_calls[k].std_error()
+                  << std::setw(14) << heston_price(OptionType::Call, heston, process_strikes[k], T)
+                  << std::setw(11) << gbm_calls[k].mean() << " +/- " << std::setw(6) << gbm_calls[k].std_error()
+                  << std::setw(14)
+                  << black_scholes(OptionType::Call, S0, process_strikes[k], risk_free_rate, sigma, T).price
+                  << std::endl;
+    }
+    std::cout << "Heston: " << std::setprecision(3) << heston_seconds << " s, GBM: " << gbm_seconds << " s"
+              << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 14. MERTON JUMP-DIFFUSION ---
+    // About one jump a year; groups of lanes where no path jumped skip the jump code
+    MertonParameters merton;
+    merton.S0 = S0;
+    merton.r = risk_free_rate;
+    merton.sigma = sigma;
+    double merton_seconds = 0.0;
+    std::vector<RunningStats> merton_calls = simulate_calls(
+        ProcessSimulator<MertonProcess>(MertonProcess(merton, engine.isa()), engine), merton_seconds);
+
+    std::cout << "--- Merton Jump-Diffusion Calls (" << process_paths << " paths x " << process_steps << " steps) ---"
+              << std::endl;
+    std::cout << std::setprecision(2) << "lambda = " << merton.lambda << ", jump mean = " << merton.jump_mean
+              << ", jump vol = " << merton.jump_vol << std::endl;
+    std::cout << std::left << std::setw(10) << "Strike" << std::right << std::setw(22) << "Monte Carlo"
+              << std::setw(14) << "Merton series" << std::endl;
+    for (std::size_t k = 0; k < process_strikes.size(); ++k) {
+        std::cout << std::left << std::setw(10) << std::setprecision(0) << process_strikes[k] << std::right
+                  << std::setprecision(4) << std::setw(11) << merton_calls[k].mean() << " +/- " << std::setw(6)
+                  << merton_calls[k].std_error()
+                  << std::setw(14) << merton_price(OptionType::Call, merton, process_strikes[k], T) << std::endl;
+    }
+    std::cout << "Merton: " << std::setprecision(3) << merton_seconds << " s (GBM: " << gbm_seconds << " s)"
+              << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 15. MULTI-ASSET BASKET AND RAINBOW OPTIONS ---
+    // Five correlated assets; the geometric basket has a closed form to check against
+    BasketParameters basket;
+    basket.r = risk_free_rate;
+    basket.S0 = {100.0, 95.0, 105.0, 100.0, 90.0};
+    basket.sigma = {0.20, 0.25, 0.18, 0.30, 0.22};
+    const std::size_t num_assets = basket.S0.size();
+    basket.correlation.assign(num_assets * num_assets, 0.4);
+    for (std::size_t i = 0; i < num_assets; ++i) {
+        basket.correlation[i * num_assets + i] = 1.0;
+    }
+    std::size_t basket_paths = 200000;
+    struct BasketCase {
+        const char* name;
+        BasketStyle style;
+    };
+    const BasketCase basket_cases[] = {
+        {"Geometric basket call", BasketStyle::Geometric},
+        {"Arithmetic basket call", BasketStyle::Arithmetic},
+        {"Best-of call", BasketStyle::BestOf},
+        {"Worst-of call", BasketStyle::WorstOf},
+    };
+
+    std::cout << "--- Basket Options (" << num_assets << " assets, correlation 0.4, K = $" << std::setprecision(2)
+              << S0 << ", " << basket_paths << " paths) ---" << std::endl;
+    std::cout << std::left << std::setw(24) << "Option" << std::right << std::setw(22) << "Monte Carlo"
+              << std::setw(14) << "Closed form" << std::endl;
+    for (const BasketCase& basket_case : basket_cases) {
+        Estimate price = price_basket_option(engine, basket, basket_case.style, OptionType::Call, S0, T,
+                                             basket_paths);
+        std::cout << std::left << std::setw(24) << basket_case.name << std::right << std::setprecision(4)
+                  << std::setw(11) << price.value << " +/- " << std::setw(6) << price.std_error;
+        if (basket_case.style == BasketStyle::Geometric) {
+            std::cout << std::setw(14) << geometric_basket_price(basket, OptionType::Call, S0, T);
+        }
+        std::cout << std::endl;
+    }
     std::cout << "------------------------------------" << std::endl;
 
+    // --- 16. MULTILEVEL MONTE CARLO ---
+    // Coupled coarse/fine paths put most of the work on the cheap one-step level
+    MlmcConfig mlmc_config;
+    mlmc_config.target_rmse = 0.02;
+    struct MlmcCase {
+        const char* name;
+        const PathPayoff* payoff;
+    };
+    const MlmcCase mlmc_cases[] = {
+        {"Arithmetic Asian call", &arithmetic_asian},
+        {"Geometric Asian call", &geometric_asian},
+    };
+
+    std::cout << "--- Multilevel Monte Carlo (target RMSE " << std::setprecision(3) << mlmc_config.target_rmse
+              << ") ---" << std::endl;
+    for (const MlmcCase& mlmc_case : mlmc_cases) {
+        auto mlmc_start = std::chrono::steady_clock::now();
+        MlmcResult mlmc = run_mlmc(engine, risk_neutral, *mlmc_case.payoff, mlmc_config);
+        std::chrono::duration<double> mlmc_elapsed = std::chrono::steady_clock::now() - mlmc_start;
+        const int finest_steps = mlmc.levels.back().steps;
+
+        std::cout << mlmc_case.name << ": " << std::setprecision(4) << mlmc.value << " (RMSE ~" << mlmc.rmse
+                  << (mlmc.converged ? "" : ", max level reached") << ")";
+        if (mlmc_case.payoff == &geometric_asian) {
+            std::cout << ", closed form at " << finest_steps << " steps: "
+                      << geometric_asian_price(OptionType::Call, S0, at_the_money, risk_free_rate, sigma, T,
+                                               finest_steps);
+        }
+        std::cout << std::endl;
+        std::cout << std::left << std::setw(8) << "Level" << std::right << std::setw(8) << "Steps" << std::setw(12)
+                  << "Paths" << std::setw(14) << "Mean" << std::setw(14) << "Variance" << std::endl;
+        for (std::size_t l = 0; l < mlmc.levels.size(); ++l) {
+            const MlmcLevel& level = mlmc.levels[l];
+            std::cout << std::left << std::setw(8) << l << std::right << std::setw(8) << level.steps
+                      << std::setw(12) << level.paths << std::scientific << std::setprecision(3) << std::setw(14)
+                      << level.mean << std::setw(14) << level.variance << std::fixed << std::endl;
+        }
+        std::cout << std::setprecision(3) << "Cost: " << std::scientific << mlmc.cost << " steps vs "
+                  << mlmc.single_level_cost << " for single-level MC at " << finest_steps << " steps"
+                  << std::fixed << std::setprecision(1) << " (" << mlmc.single_level_cost / mlmc.cost
+                  << "x saving), " << std::setprecision(3) << mlmc_elapsed.count() << " s" << std::endl;
+    }
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 17. ADAPTIVE STOPPING ON A TARGET ERROR ---
+    // Each option gets the paths its own variance calls for instead of a fixed count
+    const double discount = std::exp(-risk_free_rate * T);
+    StoppingRule stopping_rule;
+    stopping_rule.target_std_error = 0.01;
+    struct AdaptiveCase {
+        const char* name;
+        double strike;
+        OptionType type;
+    };
+    const AdaptiveCase adaptive_cases[] = {
+        {"Deep OTM call (K = 150)", 150.0, OptionType::Call},
+        {"OTM put (K = 80)", 80.0, OptionType::Put},
+        {"ATM call (K = 100)", 100.0, OptionType::Call},
+        {"Deep ITM call (K = 60)", 60.0, OptionType::Call},
+    };
+
+    std::cout << "--- Adaptive Stopping (target standard error " << std::setprecision(3)
+              << stopping_rule.target_std_error << ") ---" << std::endl;
+    std::cout << std::left << std::setw(26) << "Option" << std::right << std::setw(10) << "Price" << std::setw(10)
+              << "Error" << std::setw(12) << "Paths" << std::setw(9) << "Batches" << std::setw(14)
+              << "Black-Scholes" << std::endl;
+    for (const AdaptiveCase& adaptive_case : adaptive_cases) {
+        const double adaptive_strike = adaptive_case.strike;
+        const OptionType adaptive_type = adaptive_case.type;
+        AdaptiveEstimate adaptive = engine.estimate_to_target(risk_neutral, stopping_rule, [&](double price) {
+            return discount * ((adaptive_type == OptionType::Call) ? std::max(price - adaptive_strike, 0.0)
+                                                                   : std::max(adaptive_strike - price, 0.0));
+        });
+        std::cout << std::left << std::setw(26) << adaptive_case.name << std::right << std::setprecision(4)
+                  << std::setw(10) << adaptive.estimate.value << std::setw(10) << adaptive.estimate.std_error
+                  << std::setw(12) << adaptive.estimate.num_paths << std::setw(9) << adaptive.batches
+                  << std::setw(14)
+                  << black_scholes(adaptive_type, S0, adaptive_strike, risk_free_rate, sigma, T).price
+                  << (adaptive.target_met ? "" : "  (budget reached)") << std::endl;
+    }
+
+    // A confidence-interval target on the same ATM call, with the control variate switched on
+    StoppingRule interval_rule;
+    interval_rule.target_ci_width = 0.02;
+    interval_rule.confidence = 0.99;
+    EngineConfig adaptive_cv_config = config;
+    adaptive_cv_config.variance_reduction.control_variate = true;
+    MonteCarloEngine adaptive_cv_engine(adaptive_cv_config);
+    AdaptiveEstimate interval = adaptive_cv_engine.estimate_to_target(risk_neutral, interval_rule, [&](double price) {
+        return discount * std::max(price - at_the_money, 0.0);
+    });
+    std::cout << "ATM call to a 99% interval of width " << std::setprecision(2) << interval_rule.target_ci_width
+              << " with the control variate: " << std::setprecision(4) << interval.estimate.value << " +/- "
+              << interval.ci_half_width << " after " << interval.estimate.num_paths << " paths" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 18. PORTFOLIO VALUE-AT-RISK ---
+    // One set of 10-day scenarios for the five basket assets, shared by every position
+    const double risk_horizon = 10.0 / 252.0;
+    std::size_t risk_scenarios = 100000;
+    ScenarioSet scenarios = generate_scenarios(engine, basket, risk_horizon, risk_scenarios);
+
+    // A single share has a lognormal loss whose quantile is known exactly
+    std::vector<Position> single_stock = {Position()};
+    RiskReport stock_risk = portfolio_risk(engine, basket, single_stock, scenarios);
+    const double stock_quantile = basket.S0[0] * (1.0 - std::exp((basket.r - 0.5 * basket.sigma[0] * basket.sigma[0])
+                                                                 * risk_horizon
+                                                                 + basket.sigma[0] * std::sqrt(risk_horizon)
+                                                                 * inverse_normal_cdf(0.01)));
+
+    // A book of stocks and long and short options on all five assets
+    std::vector<Position> book;
+    for (std::size_t i = 0; i < 200; ++i) {
+        Position position;
+        position.underlying = i % num_assets;
+        position.instrument = (i % 4 == 0) ? InstrumentType::Stock
+                            : (i % 2 == 0) ? InstrumentType::Call : InstrumentType::Put;
+        position.strike = basket.S0[position.underlying] * (0.9 + 0.05 * static_cast<double>(i % 5));
+        position.maturity = 0.25 * static_cast<double>(1 + i % 4);
+        position.quantity = (i % 3 == 0) ? -100.0 : 100.0;
+        book.push_back(position);
+    }
+    auto risk_start = std::chrono::steady_clock::now();
+    RiskReport book_risk = portfolio_risk(engine, basket, book, scenarios);
+    std::chrono::duration<double> risk_elapsed = std::chrono::steady_clock::now() - risk_start;
+
+    std::cout << "--- Portfolio Risk (99%, 10 days, " << risk_scenarios << " scenarios) ---" << std::endl;
+    std::cout << std::left << std::setw(24) << "Portfolio" << std::right << std::setw(14) << "Value"
+              << std::setw(12) << "VaR" << std::setw(12) << "ES" << std::endl;
+    std::cout << std::left << std::setw(24) << "One share of asset 1" << std::right << std::setprecision(2)
+              << std::setw(14) << stock_risk.base_value << std::setw(12) << stock_risk.value_at_risk
+              << std::setw(12) << stock_risk.expected_shortfall << "  (exact VaR " << stock_quantile << ")"
+              << std::endl;
+    std::cout << std::left << std::setw(24) << "200-position book" << std::right << std::setw(14)
+              << book_risk.base_value << std::setw(12) << book_risk.value_at_risk << std::setw(12)
+              << book_risk.expected_shortfall << std::endl;
+    std::cout << "Book revalued in " << std::setprecision(3) << risk_elapsed.count() << " s" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 19. HETEROGENEOUS BOOK ON THE WORK-STEALING SCHEDULER ---
+    // One-step vanillas next to 1000-step exotics: per-path costs differ by three orders of magnitude
+    AsianOption vanilla_call(OptionType::Call, at_the_money);  // One averaging date is a European call
+    GbmParameters one_step = risk_neutral;
+    one_step.steps = 1;
+    GbmParameters fine_grid = risk_neutral;
+    fine_grid.steps = 1000;
+    struct BookCase {
+        const char* name;
+        BookEntry entry;
+    };
+    const std::vector<BookCase> book_cases = {
+        {"European call (1 step)", {one_step, &vanilla_call, 200000}},
+        {"Arithmetic Asian (252)", {risk_neutral, &arithmetic_asian, 20000}},
+        {"Down-and-out (1000)", {fine_grid, &down_and_out, 20000}},
+        {"European call (1 step)", {one_step, &vanilla_call, 100000}},
+        {"Lookback call (1000)", {fine_grid, &lookback_call, 20000}},
+    };
+    std::vector<BookEntry> pricing_book;
+    for (const BookCase& book_case : book_cases) {
+        pricing_book.push_back(book_case.entry);
+    }
+
+    // The same book on several pool sizes: the scheduler differs, the bits do not
+    const unsigned book_thread_counts[] = {1, 3, 8};
+    std::vector<std::vector<Estimate>> book_prices;
+    std::vector<SchedulerStats> book_stats;
+    std::vector<double> book_seconds;
+    for (unsigned threads : book_thread_counts) {
+        EngineConfig book_config = config;
+        book_config.num_threads = threads;
+        MonteCarloEngine book_engine(book_config);
+        auto book_start = std::chrono::steady_clock::now();
+        book_prices.push_back(price_book(book_engine, pricing_book));
+        book_seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - book_start).count());
+        book_stats.push_back(book_engine.thread_pool().stats());
+    }
+
+    std::cout << "--- Book Pricing (" << pricing_book.size() << " instruments, work stealing) ---" << std::endl;
+    std::cout << std::left << std::setw(26) << "Instrument" << std::right << std::setw(10) << "Paths"
+              << std::setw(22) << "Price" << std::endl;
+    bool book_identical = true;
+    for (std::size_t i = 0; i < pricing_book.size(); ++i) {
+        const Estimate& price = book_prices[0][i];
+        std::cout << std::left << std::setw(26) << book_cases[i].name << std::right << std::setw(10)
+                  << price.num_paths << std::setprecision(4) << std::setw(11) << price.value << " +/- "
+                  << std::setw(6) << price.std_error << std::endl;
+        for (const std::vector<Estimate>& other : book_prices) {
+            book_identical = book_identical && other[i].value == price.value
+                          && other[i].std_error == price.std_error;
+        }
+    }
+    std::cout << "Identical bits on 1, 3 and 8 threads: " << (book_identical ? "yes" : "NO") << std::endl;
+    for (std::size_t t = 0; t < book_stats.size(); ++t) {
+        std::cout << std::setw(2) << book_thread_counts[t] << " thread(s): " << std::setprecision(3)
+                  << book_seconds[t] << " s, " << book_stats[t].tasks << " tasks, " << book_stats[t].steals
+                  << " steals, " << book_stats[t].failed_steals << " failed steals, " << book_stats[t].idle_seconds
+                  << " s idle" << std::endl;
+    }
+    std::cout << "------------------------------------" << std::endl;
+
+    // --- 20. SINGLE AND MIXED PRECISION ---
+    // Paths stepped in float on float normals, payoffs summed in double; the harness pairs float
+    // and double paths. Box-Muller stays in double, which bounds the float speedup here
+    std::size_t precision_paths = 200000;
+    auto precision_call = [&](double price) { return discount * std::max(price - at_the_money, 0.0); };
+    GbmPathEngine<double> double_paths(engine);
+    GbmPathEngine<float> float_paths(engine);
+    auto double_start = std::chrono::steady_clock::now();
+    Estimate double_price = double_paths.estimate(risk_neutral, precision_paths, precision_call);
+    std::chrono::duration<double> double_elapsed = std::chrono::steady_clock::now() - double_start;
+    auto float_start = std::chrono::steady_clock::now();
+    Estimate float_price = float_paths.estimate(risk_neutral, precision_paths, precision_call);
+    std::chrono::duration<double> float_elapsed = std::chrono::steady_clock::now() - float_start;
+
+    std::cout << "--- Mixed Precision (" << precision_paths << " paths x " << steps << " steps) ---" << std::endl;
+    std::cout << "ATM call, double paths: " << std::setprecision(4) << double_price.value << " +/- "
+              << double_price.std_error << " in " << std::setprecision(3) << double_elapsed.count() << " s"
+              << std::endl;
+    std::cout << "ATM call, float paths:  " << std::setprecision(4) << float_price.value << " +/- "
+              << float_price.std_error << " in " << std::setprecision(3) << float_elapsed.count() << " s ("
+              << std::setprecision(2) << double_elapsed.count() / float_elapsed.count() << "x faster)" << std::endl;
+
+    struct PrecisionCase {
+        const char* name;
+        std::function<double(double)> payoff;
+    };
+    const PrecisionCase precision_cases[] = {
+        {"ATM call", precision_call},
+        {"OTM call (K = 130)", [&](double price) { return discount * std::max(price - 130.0, 0.0); }},
+        {"OTM put (K = 80)", [&](double price) { return discount * std::max(80.0 - price, 0.0); }},
+        {"Digital call (K = 100)", [&](double price) { return price > at_the_money ? discount : 0.0; }},
+    };
+    std::cout << std::left << std::setw(24) << "Payoff" << std::right << std::setw(12) << "Double"
+              << std::setw(24) << "Float - double" << std::setw(14) << "Bias bound" << std::endl;
+    double worst_price_error = 0.0;
+    for (const PrecisionCase& precision_case : precision_cases) {
+        PrecisionBias bias = measure_precision_bias(engine, risk_neutral, precision_paths, precision_case.payoff);
+        worst_price_error = std::max(worst_price_error, bias.max_relative_price_error);
+        std::cout << std::left << std::setw(24) << precision_case.name << std::right << std::setprecision(4)
+                  << std::setw(12) << bias.reference << std::scientific << std::setprecision(2) << std::setw(11)
+                  << bias.bias << " +/- " << std::setw(8) << bias.bias_std_error << std::setw(14) << bias.bound
+                  << std::fixed << std::endl;
+    }
+    std::cout << "Largest relative error of a float S_T: " << std::scientific << std::setprecision(2)
+              << worst_price_error << std::fixed << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+
+    // --- 21. PER-PHASE INSTRUMENTATION ---
+    // Where an Asian pricing run spends its time; the timers only exist in QUANT_INSTRUMENTATION builds
+    std::size_t instrumented_paths = 50000;
+    begin_instrumented_run();
+    Estimate instrumented_price = price_path_dependent(engine, risk_neutral, arithmetic_asian, instrumented_paths);
+    InstrumentationReport instrumentation = end_instrumented_run(instrumented_paths, engine.num_threads());
+
+    std::cout << "--- Instrumented Asian Call (" << instrumented_paths << " paths) ---" << std::endl;
+    std::cout << "Price: $" << std::setprecision(4) << instrumented_price.value << std::endl;
+    if (instrumentation.enabled) {
+        write_instrumentation_json(std::cout, instrumentation);
+    } else {
+        std::cout << "Instrumentation compiled out (configure with -DQUANT_INSTRUMENTATION=ON)" << std::endl;
+    }
+    std::cout << "-----------------------------------------------" << std::endl;
+
+
+    // --- 22. MEMORY-MAPPED PATH STORE ---
+    // Month-end prices of every path go to a columnar file that downstream tools map and read in place
+    std::size_t stored_paths = 100000;
+    std::vector<std::size_t> month_ends;
+    for (int month = 1; month <= 12; ++month) {
+        month_ends.push_back(static_cast<std::size_t>(month * steps / 12));
+    }
+    // The process id keeps concurrent runs from truncating each other's file
+    const std::string store_file = (std::filesystem::temp_directory_path()
+                                    / ("quant_paths_" + std::to_string(::getpid()) + ".bin")).string();
+    auto store_start = std::chrono::steady_clock::now();
+    PathStoreHeader written = write_path_store(engine, risk_neutral, stored_paths, month_ends, store_file);
+    std::chrono::duration<double> store_elapsed = std::chrono::steady_clock::now() - store_start;
+
+    std::cout << "--- Path Store (" << stored_paths << " paths x " << written.num_observations
+              << " month ends) ---" << std::endl;
+    std::cout << "Wrote " << std::setprecision(1) << static_cast<double>(written.file_bytes) / 1e6 << " MB in "
+              << std::setprecision(3) << store_elapsed.count() << " s ("
+              << std::setprecision(0) << static_cast<double>(written.file_bytes) / 1e6 / store_elapsed.count()
+              << " MB/s), chunks of " << written.chunk_paths << " paths" << std::endl;
+    {
+        PathStore store(store_file);
+        std::cout << std::left << std::setw(8) << "Month" << std::right << std::setw(14) << "Mean S_t"
+                  << std::setw(14) << "S0 e^(rt)" << std::endl;
+        for (std::size_t k = 2; k < store.num_observations(); k += 3) {
+            // Sum the time slice chunk by chunk, straight from the mapping, weighted
+            // by dP/dQ if the paths were drawn under an importance shift
+            double slice_sum = 0.0;
+            store.for_each_slice_run(k, 0, store.num_paths(), [&](std::size_t first_path, const double* prices,
+                                                                  std::size_t count) {
+                const double* weights = store.weight_run(first_path, count);
+                for (std::size_t p = 0; p < count; ++p) {
+                    slice_sum += (weights ? weights[p] : 1.0) * prices[p];
+                }
+            });
+            const double t = T * static_cast<double>(store.observation_step(k)) / steps;
+            std::cout << std::left << std::setw(8) << k + 1 << std::right << std::setprecision(4) << std::setw(14)
+                      << slice_sum / static_cast<double>(store.num_paths()) << std::setw(14)
+                      << S0 * std::exp(risk_free_rate * t) << std::endl;
+        }
+        std::vector<double> one_path(store.num_observations());
+        store.read_path(stored_paths / 2, one_path.data());
+        std::cout << "Path " << stored_paths / 2 << " month ends: $" << std::setprecision(2) << one_path.front()
+                  << " ... $" << one_path.back() << std::endl;
+    }
+    std::filesystem::remove(store_file);
+    std::cout << "------------------------------------------" << std::endl;
+
     return 0;
 }
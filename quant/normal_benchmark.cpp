@@ -0,0 +1,169 @@
+// normal_benchmark.cpp
+// Measures how fast PathNormalGenerator fills step-major blocks of normals on
+// every instruction set this CPU supports, and checks each generator's output:
+// its first four moments and a Kolmogorov-Smirnov test against N(0, 1), its
+// distance from the scalar generator, that block boundaries do not change a
+// single bit, and that float blocks are the double normals rounded once.
+// Exits with status 1 if any check fails.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include "normal_math.h"
+#include "philox.h"
+
+namespace {
+
+// Largest distance between the empirical CDF of the sorted sample and the normal CDF
+double ks_statistic(const std::vector<double>& sorted) {
+    const double n = static_cast<double>(sorted.size());
+    double d = 0.0;
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        const double cdf = normal_cdf(sorted[i]);
+        d = std::max(d, std::max(static_cast<double>(i + 1) / n - cdf, cdf - static_cast<double>(i) / n));
+    }
+    return d;
+}
+
+} // namespace
+
+int main() {
+    // --- 1. BENCHMARK PARAMETERS ---
+    const std::uint64_t seed = 42;
+    const std::size_t block_paths = 4096;    // Paths per block (one engine block)
+    const std::size_t tile_steps = 8;        // Steps per block (one engine tile)
+    const int repetitions = 2000;            // Blocks generated per measurement
+    const std::size_t sample_paths = 1 << 17;
+    const std::size_t sample_steps = 8;      // 2^20 normals for the statistical checks
+    const double max_z_score = 4.0;          // Moment checks fail beyond this many standard errors
+    const double ks_critical = 1.628;        // sqrt(n) * D at the 1% level
+
+    std::cout << "--- Normal Generator Benchmark ---" << std::endl;
+    std::cout << "Block: " << block_paths << " paths x " << tile_steps << " steps, " << repetitions
+              << " blocks; checks on " << sample_paths * sample_steps << " normals" << std::endl;
+    std::cout << "----------------------------------" << std::endl;
+
+    // --- 2. THROUGHPUT OF EACH SUPPORTED GENERATOR ---
+    std::vector<double> block(block_paths * tile_steps);
+    double scalar_rate = 0.0;
+    const SimdIsa all_isas[] = {SimdIsa::Scalar, SimdIsa::Avx2, SimdIsa::Avx512};
+    for (SimdIsa isa : all_isas) {
+        if (!simd_isa_supported(isa)) {
+            std::cout << std::left << std::setw(8) << simd_isa_name(isa) << " not supported on this CPU" << std::endl;
+            continue;
+        }
+        const PathNormalGenerator normals(seed, 0, isa);
+        double checksum = 0.0;
+
+        auto start_time = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < repetitions; ++rep) {
+            normals.fill_block(static_cast<std::uint64_t>(rep) * block_paths, block_paths, 0, tile_steps,
+                               block.data());
+            checksum += block[rep % block.size()];
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+
+        const double normals_per_second = static_cast<double>(block.size()) * repetitions / elapsed.count();
+        if (isa == SimdIsa::Scalar) {
+            scalar_rate = normals_per_second;
+        }
+        std::cout << std::left << std::setw(8) << simd_isa_name(isa)
+                  << std::right << std::fixed << std::setprecision(0) << std::setw(14) << normals_per_second
+                  << " normals/s" << std::setprecision(2) << std::setw(8) << normals_per_second / scalar_rate << "x"
+                  << "  (checksum " << std::setprecision(4) << checksum / repetitions << ")" << std::endl;
+    }
+
+    // --- 3. STATISTICAL CHECKS ---
+    std::cout << "----------------------------------" << std::endl;
+    std::cout << std::left << std::setw(8) << "ISA" << std::right << std::setw(11) << "Mean" << std::setw(11)
+              << "Variance" << std::setw(11) << "Skew" << std::setw(11) << "Ex. kurt" << std::setw(11) << "KS D"
+              << std::setw(13) << "vs scalar" << std::setw(8) << "Result" << std::endl;
+
+    const PathNormalGenerator scalar_normals(seed, 0, SimdIsa::Scalar);
+    std::vector<double> reference(sample_paths * sample_steps);
+    scalar_normals.fill_block(0, sample_paths, 0, sample_steps, reference.data());
+
+    bool all_passed = true;
+    for (SimdIsa isa : all_isas) {
+        if (!simd_isa_supported(isa)) {
+            continue;
+        }
+        const PathNormalGenerator normals(seed, 0, isa);
+        std::vector<double> sample(sample_paths * sample_steps);
+        normals.fill_block(0, sample_paths, 0, sample_steps, sample.data());
+
+        // Central moments, each compared with its standard error under N(0, 1)
+        const double n = static_cast<double>(sample.size());
+        double sum = 0.0;
+        for (double z : sample) {
+            sum += z;
+        }
+        const double mean = sum / n;
+        double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+        for (double z : sample) {
+            const double d = z - mean;
+            m2 += d * d;
+            m3 += d * d * d;
+            m4 += d * d * d * d;
+        }
+        m2 /= n;
+        m3 /= n;
+        m4 /= n;
+        const double skew = m3 / std::pow(m2, 1.5);
+        const double excess_kurtosis = m4 / (m2 * m2) - 3.0;
+        bool passed = std::fabs(mean) < max_z_score * std::sqrt(1.0 / n)
+                   && std::fabs(m2 - 1.0) < max_z_score * std::sqrt(2.0 / n)
+                   && std::fabs(skew) < max_z_score * std::sqrt(6.0 / n)
+                   && std::fabs(excess_kurtosis) < max_z_score * std::sqrt(24.0 / n);
+
+        double max_difference = 0.0;
+        for (std::size_t k = 0; k < sample.size(); ++k) {
+            max_difference = std::max(max_difference, std::fabs(sample[k] - reference[k]));
+        }
+        passed = passed && max_difference < 1e-12;
+
+        // The same normals generated in odd-sized blocks must match bit for bit
+        const std::size_t small_block = 7;
+        std::vector<double> pieces(small_block * sample_steps);
+        for (std::size_t first = 0; first < 1000; first += small_block) {
+            normals.fill_block(first, small_block, 0, sample_steps, pieces.data());
+            for (std::size_t s = 0; s < sample_steps; ++s) {
+                for (std::size_t p = 0; p < small_block; ++p) {
+                    passed = passed && pieces[s * small_block + p] == sample[s * sample_paths + first + p];
+                }
+            }
+        }
+
+        // Float blocks (odd-sized too) must be the double normals rounded once
+        std::vector<float> rounded(small_block * sample_steps);
+        for (std::size_t first = 0; first < 1000; first += small_block) {
+            normals.fill_block(first, small_block, 0, sample_steps, rounded.data());
+            for (std::size_t s = 0; s < sample_steps; ++s) {
+                for (std::size_t p = 0; p < small_block; ++p) {
+                    passed = passed && rounded[s * small_block + p]
+                                           == static_cast<float>(sample[s * sample_paths + first + p]);
+                }
+            }
+        }
+
+        std::sort(sample.begin(), sample.end());
+        const double d = ks_statistic(sample);
+        passed = passed && std::sqrt(n) * d < ks_critical;
+        all_passed = all_passed && passed;
+
+        std::cout << std::left << std::setw(8) << simd_isa_name(isa) << std::right << std::fixed
+                  << std::setprecision(5) << std::setw(11) << mean << std::setw(11) << m2 << std::setw(11) << skew
+                  << std::setw(11) << excess_kurtosis << std::setw(11) << d << std::scientific
+                  << std::setprecision(2) << std::setw(13) << max_difference << std::setw(8)
+                  << (passed ? "pass" : "FAIL") << std::endl;
+    }
+    std::cout << "KS critical value at 1%: " << std::fixed << std::setprecision(5) << ks_critical / std::sqrt(
+                     static_cast<double>(sample_paths * sample_steps)) << std::endl;
+
+    return all_passed ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+#ifndef NORMAL_MATH_H
+#define NORMAL_MATH_H
+
+// Standard normal density
+double normal_pdf(double x);
+
+// Standard normal cumulative distribution function
+double normal_cdf(double x);
+
+/**
+ * @brief Inverse of the standard normal CDF (Wichura's algorithm AS 241).
+ *
+ * Accurate to about 1e-16 relative error for p in (0, 1). Returns -inf / +inf
+ * at 0 and 1.
+ */
+double inverse_normal_cdf(double p);
+
+#endif // NORMAL_MATH_H
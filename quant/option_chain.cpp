@@ -0,0 +1,189 @@
+#include "option_chain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include "streaming_stats.h"
+
+namespace {
+
+// Weighted payoff sums of one option over many paths
+struct PayoffSums {
+    double sum = 0.0;
+    double sum_sq = 0.0;
+};
+
+// Payoff sums of every (snapshot, strike) call and put in one reduction slot
+struct ChainSums {
+    std::vector<PayoffSums> calls;  // [snapshot * num_strikes + strike]
+    std::vector<PayoffSums> puts;
+
+    void merge(const ChainSums& other) {
+        for (std::size_t k = 0; k < calls.size(); ++k) {
+            calls[k].sum += other.calls[k].sum;
+            calls[k].sum_sq += other.calls[k].sum_sq;
+            puts[k].sum += other.puts[k].sum;
+            puts[k].sum_sq += other.puts[k].sum_sq;
+        }
+    }
+};
+
+// Sums of w, w * S, w^2, w^2 * S and w^2 * S^2 over a set of paths. Payoff sums
+// for any strike follow from these, e.g. sum of w * (S - K) = sum(w S) - K sum(w).
+struct PriceMoments {
+    double w = 0.0;
+    double ws = 0.0;
+    double w2 = 0.0;
+    double w2s = 0.0;
+    double w2s2 = 0.0;
+
+    void add(double price, double weight) {
+        const double w2_price = weight * weight * price;
+        w += weight;
+        ws += weight * price;
+        w2 += weight * weight;
+        w2s += w2_price;
+        w2s2 += w2_price * price;
+    }
+};
+
+Estimate to_estimate(const PayoffSums& sums, std::size_t n, double discount) {
+    Estimate estimate;
+    estimate.num_paths = n;
+    if (n == 0) {
+        return estimate;
+    }
+    const double count = static_cast<double>(n);
+    const double mean = sums.sum / count;
+    const double variance = (n > 1) ? std::max(sums.sum_sq - count * mean * mean, 0.0) / (count - 1.0) : 0.0;
+    estimate.value = discount * mean;
+    estimate.std_error = discount * std::sqrt(variance / count);
+    return estimate;
+}
+
+} // namespace
+
+const Estimate& PriceSurface::call(std::size_t maturity, std::size_t strike) const {
+    return calls[maturity * strikes.size() + strike];
+}
+
+const Estimate& PriceSurface::put(std::size_t maturity, std::size_t strike) const {
+    return puts[maturity * strikes.size() + strike];
+}
+
+PriceSurface price_option_chain(MonteCarloEngine& engine, const GbmParameters& params, const OptionChain& chain,
+                                std::size_t num_paths) {
+    const std::size_t num_strikes = chain.strikes.size();
+    const std::size_t num_maturities = chain.maturities.size();
+    const double dt = params.T / static_cast<double>(std::max(params.steps, 1));
+
+    PriceSurface surface;
+    surface.strikes = chain.strikes;
+    if (num_strikes == 0 || num_maturities == 0) {
+        surface.maturities = chain.maturities;
+        return surface;
+    }
+
+    // Each maturity's step, and the distinct steps the engine has to stop at
+    std::vector<std::size_t> maturity_step(num_maturities);
+    for (std::size_t m = 0; m < num_maturities; ++m) {
+        const double rounded = std::round(chain.maturities[m] / dt);
+        maturity_step[m] = static_cast<std::size_t>(std::max(rounded, 1.0));
+        surface.maturities.push_back(static_cast<double>(maturity_step[m]) * dt);
+    }
+    std::vector<std::size_t> snapshot_steps = maturity_step;
+    std::sort(snapshot_steps.begin(), snapshot_steps.end());
+    snapshot_steps.erase(std::unique(snapshot_steps.begin(), snapshot_steps.end()), snapshot_steps.end());
+    std::vector<std::size_t> maturity_snapshot(num_maturities);
+    for (std::size_t m = 0; m < num_maturities; ++m) {
+        maturity_snapshot[m] = static_cast<std::size_t>(
+            std::lower_bound(snapshot_steps.begin(), snapshot_steps.end(), maturity_step[m]) - snapshot_steps.begin());
+    }
+    const std::size_t num_snapshots = snapshot_steps.size();
+
+    // Simulate on the same step size up to the last maturity
+    GbmParameters horizon = params;
+    horizon.steps = static_cast<int>(snapshot_steps.back());
+    horizon.T = static_cast<double>(horizon.steps) * dt;
+
+    // Strikes from highest to lowest, for one downward sweep over sorted prices
+    std::vector<std::size_t> strike_order(num_strikes);
+    std::iota(strike_order.begin(), strike_order.end(), 0);
+    std::sort(strike_order.begin(), strike_order.end(),
+              [&](std::size_t a, std::size_t b) { return chain.strikes[a] > chain.strikes[b]; });
+
+    // Per-worker state: the current chunk's snapshots and sort scratch. The
+    // payoff sums go to the engine's reduction slots.
+    struct WorkerState {
+        std::vector<double> snapshots;                  // snapshots[i * chunk + p]
+        std::vector<std::pair<double, double>> sorted;  // (price, weight)
+    };
+    std::vector<WorkerState> workers(engine.num_threads());
+    ChainSums empty;
+    empty.calls.resize(num_snapshots * num_strikes);
+    empty.puts.resize(num_snapshots * num_strikes);
+    std::vector<ChainSums> slots(engine.reduction_slots(num_paths), empty);
+
+    auto observer = [&](std::size_t, std::size_t step, const double* prices, std::size_t count, unsigned worker) {
+        WorkerState& state = workers[worker];
+        if (state.snapshots.size() < num_snapshots * count) {
+            state.snapshots.resize(num_snapshots * count);
+        }
+        const std::size_t i = static_cast<std::size_t>(
+            std::lower_bound(snapshot_steps.begin(), snapshot_steps.end(), step) - snapshot_steps.begin());
+        std::copy(prices, prices + count, state.snapshots.begin() + i * count);
+    };
+
+    auto consumer = [&](std::size_t first_path, const double*, const double* weights, std::size_t count,
+                        unsigned worker) {
+        WorkerState& state = workers[worker];
+        ChainSums& sums = slots[engine.reduction_slot(first_path, worker)];
+        for (std::size_t i = 0; i < num_snapshots; ++i) {
+            const double* snapshot = state.snapshots.data() + i * count;
+            state.sorted.resize(count);
+            PriceMoments total;
+            for (std::size_t p = 0; p < count; ++p) {
+                state.sorted[p] = std::make_pair(snapshot[p], weights[p]);
+                total.add(snapshot[p], weights[p]);
+            }
+            std::sort(state.sorted.begin(), state.sorted.end());
+
+            // Walk strikes downwards while collecting the paths that end above each one
+            PriceMoments above;
+            std::size_t next = count;
+            for (std::size_t k : strike_order) {
+                const double strike = chain.strikes[k];
+                while (next > 0 && state.sorted[next - 1].first > strike) {
+                    --next;
+                    above.add(state.sorted[next].first, state.sorted[next].second);
+                }
+                // Calls pay on paths above the strike, puts on the rest (paths at the strike pay nothing)
+                PayoffSums& call = sums.calls[i * num_strikes + k];
+                call.sum += above.ws - strike * above.w;
+                call.sum_sq += above.w2s2 - 2.0 * strike * above.w2s + strike * strike * above.w2;
+
+                PayoffSums& put = sums.puts[i * num_strikes + k];
+                put.sum += strike * (total.w - above.w) - (total.ws - above.ws);
+                put.sum_sq += strike * strike * (total.w2 - above.w2) - 2.0 * strike * (total.w2s - above.w2s)
+                            + (total.w2s2 - above.w2s2);
+            }
+        }
+    };
+
+    engine.for_each_observed_block(horizon, num_paths, snapshot_steps, observer, consumer);
+    const ChainSums total = merge_pairwise(slots);
+
+    surface.calls.resize(num_maturities * num_strikes);
+    surface.puts.resize(num_maturities * num_strikes);
+    for (std::size_t m = 0; m < num_maturities; ++m) {
+        const double discount = std::exp(-params.mu * surface.maturities[m]);
+        const std::size_t i = maturity_snapshot[m];
+        for (std::size_t k = 0; k < num_strikes; ++k) {
+            surface.calls[m * num_strikes + k] = to_estimate(total.calls[i * num_strikes + k], num_paths, discount);
+            surface.puts[m * num_strikes + k] = to_estimate(total.puts[i * num_strikes + k], num_paths, discount);
+        }
+    }
+    return surface;
+}
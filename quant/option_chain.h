@@ -0,0 +1,49 @@
+#ifndef OPTION_CHAIN_H
+#define OPTION_CHAIN_H
+
+#include <cstddef>
+#include <vector>
+
+#include "monte_carlo_engine.h"
+
+// Every combination of these strikes and maturities, for calls and puts
+struct OptionChain {
+    std::vector<double> strikes;
+    std::vector<double> maturities;     // In years
+};
+
+/**
+ * @brief European call and put prices over a strike/maturity grid.
+ *
+ * Entry [m * strikes.size() + k] holds maturity m and strike k. Maturities
+ * are the ones actually priced, i.e. rounded to whole time steps.
+ */
+struct PriceSurface {
+    std::vector<double> strikes;
+    std::vector<double> maturities;
+    std::vector<Estimate> calls;
+    std::vector<Estimate> puts;
+
+    const Estimate& call(std::size_t maturity, std::size_t strike) const;
+    const Estimate& put(std::size_t maturity, std::size_t strike) const;
+};
+
+/**
+ * @brief Prices a whole option chain from one set of simulated paths.
+ *
+ * params.mu is the risk-free rate and params.T / params.steps the time step;
+ * each maturity is rounded to the nearest step and the simulation runs to the
+ * last one. Every path is snapshotted at each maturity's step, and all strikes
+ * of that maturity are priced from the same snapshot (common random numbers),
+ * so the number of paths does not grow with the size of the chain. With
+ * exact_terminal on, the engine only simulates the maturity steps.
+ *
+ * Each chunk's snapshot is sorted once and all its strikes are then priced in
+ * one sweep over running sums, instead of one pass over the paths per strike.
+ * Standard errors assume independent paths; with antithetic pairs they are
+ * conservative and for quasi-random sampling they are only indicative.
+ */
+PriceSurface price_option_chain(MonteCarloEngine& engine, const GbmParameters& params, const OptionChain& chain,
+                                std::size_t num_paths);
+
+#endif // OPTION_CHAIN_H
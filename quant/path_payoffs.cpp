@@ -0,0 +1,206 @@
+#include "path_payoffs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "normal_math.h"
+#include "streaming_stats.h"
+
+namespace {
+
+double vanilla_payoff(OptionType type, double underlying, double strike) {
+    return (type == OptionType::Call) ? std::max(underlying - strike, 0.0) : std::max(strike - underlying, 0.0);
+}
+
+} // namespace
+
+// --- AsianOption ---
+
+AsianOption::AsianOption(OptionType type, double strike, Averaging averaging)
+    : type(type), strike(strike), averaging(averaging) {}
+
+std::size_t AsianOption::state_size() const {
+    return 2;   // Running sum (of prices or of log prices) and number of prices seen
+}
+
+void AsianOption::initialize(double* state, std::size_t count, double) const {
+    std::fill(state, state + 2 * count, 0.0);
+}
+
+void AsianOption::update(double* state, const double* prices, std::size_t count, std::size_t) const {
+    double* sum = state;
+    double* seen = state + count;
+    if (averaging == Averaging::Arithmetic) {
+        for (std::size_t p = 0; p < count; ++p) {
+            sum[p] += prices[p];
+        }
+    } else {
+        for (std::size_t p = 0; p < count; ++p) {
+            sum[p] += std::log(prices[p]);
+        }
+    }
+    for (std::size_t p = 0; p < count; ++p) {
+        seen[p] += 1.0;
+    }
+}
+
+void AsianOption::payoff(const double* state, const double*, std::size_t count, double* out) const {
+    const double* sum = state;
+    const double* seen = state + count;
+    for (std::size_t p = 0; p < count; ++p) {
+        const double mean = sum[p] / seen[p];
+        const double average = (averaging == Averaging::Arithmetic) ? mean : std::exp(mean);
+        out[p] = vanilla_payoff(type, average, strike);
+    }
+}
+
+// --- BarrierOption ---
+
+BarrierOption::BarrierOption(OptionType type, double strike, double barrier, BarrierType barrier_type)
+    : type(type), strike(strike), barrier(barrier), barrier_type(barrier_type) {}
+
+std::size_t BarrierOption::state_size() const {
+    return 1;   // 1 once the barrier has been touched
+}
+
+void BarrierOption::initialize(double* state, std::size_t count, double S0) const {
+    const bool up = barrier_type == BarrierType::UpAndOut || barrier_type == BarrierType::UpAndIn;
+    const bool touched = up ? S0 >= barrier : S0 <= barrier;
+    std::fill(state, state + count, touched ? 1.0 : 0.0);
+}
+
+void BarrierOption::update(double* state, const double* prices, std::size_t count, std::size_t) const {
+    // Branch-free so the loop vectorizes
+    if (barrier_type == BarrierType::UpAndOut || barrier_type == BarrierType::UpAndIn) {
+        for (std::size_t p = 0; p < count; ++p) {
+            state[p] = (prices[p] >= barrier) ? 1.0 : state[p];
+        }
+    } else {
+        for (std::size_t p = 0; p < count; ++p) {
+            state[p] = (prices[p] <= barrier) ? 1.0 : state[p];
+        }
+    }
+}
+
+void BarrierOption::payoff(const double* state, const double* final_prices, std::size_t count, double* out) const {
+    const bool knock_in = barrier_type == BarrierType::UpAndIn || barrier_type == BarrierType::DownAndIn;
+    for (std::size_t p = 0; p < count; ++p) {
+        const bool alive = knock_in ? state[p] != 0.0 : state[p] == 0.0;
+        out[p] = alive ? vanilla_payoff(type, final_prices[p], strike) : 0.0;
+    }
+}
+
+// --- LookbackOption ---
+
+LookbackOption::LookbackOption(OptionType type) : type(type) {}
+
+std::size_t LookbackOption::state_size() const {
+    return 1;   // Running minimum for a call, running maximum for a put
+}
+
+void LookbackOption::initialize(double* state, std::size_t count, double S0) const {
+    std::fill(state, state + count, S0);
+}
+
+void LookbackOption::update(double* state, const double* prices, std::size_t count, std::size_t) const {
+    if (type == OptionType::Call) {
+        for (std::size_t p = 0; p < count; ++p) {
+            state[p] = std::min(state[p], prices[p]);
+        }
+    } else {
+        for (std::size_t p = 0; p < count; ++p) {
+            state[p] = std::max(state[p], prices[p]);
+        }
+    }
+}
+
+void LookbackOption::payoff(const double* state, const double* final_prices, std::size_t count, double* out) const {
+    for (std::size_t p = 0; p < count; ++p) {
+        out[p] = (type == OptionType::Call) ? final_prices[p] - state[p] : state[p] - final_prices[p];
+    }
+}
+
+// --- Pricing ---
+
+Estimate price_path_dependent(MonteCarloEngine& engine, const GbmParameters& params, const PathPayoff& payoff,
+                              std::size_t num_paths) {
+    const double discount = std::exp(-params.mu * params.T);
+    const std::size_t state_size = payoff.state_size();
+
+    // Each worker owns the state of the chunk it is simulating; the statistics
+    // go to the engine's reduction slots so reproducible mode can fix their order
+    struct WorkerState {
+        std::vector<double> state;
+        std::vector<double> payoffs;
+    };
+    std::vector<WorkerState> workers(engine.num_threads());
+    std::vector<RunningStats> slots(engine.reduction_slots(num_paths));
+
+    auto observer = [&](std::size_t, std::size_t step, const double* prices, std::size_t count, unsigned worker) {
+        WorkerState& local = workers[worker];
+        if (step == 1) {
+            // First step of a new chunk
+            local.state.resize(state_size * count);
+            payoff.initialize(local.state.data(), count, params.S0);
+        }
+        payoff.update(local.state.data(), prices, count, step);
+    };
+
+    auto consumer = [&](std::size_t first_path, const double* prices, const double* weights, std::size_t count,
+                        unsigned worker) {
+        WorkerState& local = workers[worker];
+        local.payoffs.resize(count);
+        payoff.payoff(local.state.data(), prices, count, local.payoffs.data());
+        RunningStats& stats = slots[engine.reduction_slot(first_path, worker)];
+        for (std::size_t p = 0; p < count; ++p) {
+            stats.add(discount * weights[p] * local.payoffs[p]);
+        }
+    };
+
+    engine.for_each_observed_block(params, num_paths, std::vector<std::size_t>(), observer, consumer);
+
+    const RunningStats total = merge_pairwise(slots);
+    Estimate estimate;
+    estimate.value = total.mean();
+    estimate.std_error = total.std_error();
+    estimate.num_paths = static_cast<std::size_t>(total.count());
+    return estimate;
+}
+
+// --- Reference prices ---
+
+double geometric_asian_price(OptionType type, double S0, double strike, double rate, double sigma, double T,
+                             int steps) {
+    // log G is normal: with dt = T / n, the mean of the log prices at t_i = i dt has
+    // mean log S0 + (r - sigma^2 / 2) dt (n + 1) / 2 and variance sigma^2 dt (n + 1)(2n + 1) / (6n)
+    const double n = static_cast<double>(steps);
+    const double dt = T / n;
+    const double mean = std::log(S0) + (rate - 0.5 * sigma * sigma) * dt * (n + 1.0) / 2.0;
+    const double stdev = sigma * std::sqrt(dt * (n + 1.0) * (2.0 * n + 1.0) / (6.0 * n));
+    const double d2 = (mean - std::log(strike)) / stdev;
+    const double d1 = d2 + stdev;
+    const double forward = std::exp(mean + 0.5 * stdev * stdev);
+    const double discount = std::exp(-rate * T);
+    if (type == OptionType::Call) {
+        return discount * (forward * normal_cdf(d1) - strike * normal_cdf(d2));
+    }
+    return discount * (strike * normal_cdf(-d2) - forward * normal_cdf(-d1));
+}
+
+double discrete_down_and_out_call(double S0, double strike, double barrier, double rate, double sigma, double T,
+                                  int steps) {
+    const double shifted = barrier * std::exp(-0.5826 * sigma * std::sqrt(T / steps));
+    if (S0 <= shifted) {
+        return 0.0;
+    }
+    // Continuous down-and-in call for a barrier at or below the strike (Merton 1973)
+    const double sqrt_T = std::sqrt(T);
+    const double lambda = (rate + 0.5 * sigma * sigma) / (sigma * sigma);
+    const double y = std::log(shifted * shifted / (S0 * strike)) / (sigma * sqrt_T) + lambda * sigma * sqrt_T;
+    const double ratio = shifted / S0;
+    const double down_and_in = S0 * std::pow(ratio, 2.0 * lambda) * normal_cdf(y)
+                             - strike * std::exp(-rate * T) * std::pow(ratio, 2.0 * lambda - 2.0)
+                               * normal_cdf(y - sigma * sqrt_T);
+    return black_scholes(OptionType::Call, S0, strike, rate, sigma, T).price - down_and_in;
+}
@@ -0,0 +1,119 @@
+#ifndef PATH_PAYOFFS_H
+#define PATH_PAYOFFS_H
+
+#include <cstddef>
+
+#include "european_option.h"
+#include "monte_carlo_engine.h"
+
+/**
+ * @brief A payoff that depends on the whole path through a small per-path state.
+ *
+ * The state is updated at every time step from the current prices, so no
+ * trajectory is ever stored. It is laid out structure-of-arrays for a chunk of
+ * `count` paths: variable v of path p is state[v * count + p]. Every method
+ * works on a whole chunk at once, so the loops over paths vectorize just like
+ * the step kernel.
+ */
+class PathPayoff {
+public:
+    virtual ~PathPayoff() = default;
+
+    // Number of state variables per path
+    virtual std::size_t state_size() const = 0;
+
+    // Sets up the state of count paths that all start at S0
+    virtual void initialize(double* state, std::size_t count, double S0) const = 0;
+
+    // Folds in the prices at the given (1-based) step
+    virtual void update(double* state, const double* prices, std::size_t count, std::size_t step) const = 0;
+
+    // Writes the undiscounted payoff of every path, given its state and final price
+    virtual void payoff(const double* state, const double* final_prices, std::size_t count, double* out) const = 0;
+};
+
+// How an Asian option averages the prices at the monitoring dates
+enum class Averaging {
+    Arithmetic,
+    Geometric
+};
+
+// Fixed-strike Asian option on the average of the prices at every step
+class AsianOption : public PathPayoff {
+public:
+    AsianOption(OptionType type, double strike, Averaging averaging = Averaging::Arithmetic);
+
+    std::size_t state_size() const override;
+    void initialize(double* state, std::size_t count, double S0) const override;
+    void update(double* state, const double* prices, std::size_t count, std::size_t step) const override;
+    void payoff(const double* state, const double* final_prices, std::size_t count, double* out) const override;
+
+private:
+    OptionType type;
+    double strike;
+    Averaging averaging;
+};
+
+enum class BarrierType {
+    UpAndOut,
+    DownAndOut,
+    UpAndIn,
+    DownAndIn
+};
+
+// European option that is knocked out (or in) if the price touches the barrier at any step
+class BarrierOption : public PathPayoff {
+public:
+    BarrierOption(OptionType type, double strike, double barrier, BarrierType barrier_type);
+
+    std::size_t state_size() const override;
+    void initialize(double* state, std::size_t count, double S0) const override;
+    void update(double* state, const double* prices, std::size_t count, std::size_t step) const override;
+    void payoff(const double* state, const double* final_prices, std::size_t count, double* out) const override;
+
+private:
+    OptionType type;
+    double strike;
+    double barrier;
+    BarrierType barrier_type;
+};
+
+// Floating-strike lookback: a call pays S_T - min(S), a put pays max(S) - S_T
+class LookbackOption : public PathPayoff {
+public:
+    explicit LookbackOption(OptionType type);
+
+    std::size_t state_size() const override;
+    void initialize(double* state, std::size_t count, double S0) const override;
+    void update(double* state, const double* prices, std::size_t count, std::size_t step) const override;
+    void payoff(const double* state, const double* final_prices, std::size_t count, double* out) const override;
+
+private:
+    OptionType type;
+};
+
+/**
+ * @brief Prices a path-dependent payoff by walking every time step.
+ *
+ * params.mu is the risk-free rate. Each worker keeps the state of the chunk
+ * it is simulating and updates it after every step; importance-sampling
+ * weights are applied to the discounted payoffs.
+ */
+Estimate price_path_dependent(MonteCarloEngine& engine, const GbmParameters& params, const PathPayoff& payoff,
+                              std::size_t num_paths);
+
+// Closed-form price of a geometric Asian option averaging the prices at steps 1..steps
+double geometric_asian_price(OptionType type, double S0, double strike, double rate, double sigma, double T,
+                             int steps);
+
+/**
+ * @brief Down-and-out call with a barrier checked at steps 1..steps (barrier below the strike).
+ *
+ * Uses the continuously monitored formula with the barrier moved down by
+ * exp(0.5826 sigma sqrt(dt)), the Broadie-Glasserman-Kou correction for
+ * discrete monitoring.
+ */
+double discrete_down_and_out_call(double S0, double strike, double barrier, double rate, double sigma, double T,
+                                  int steps);
+
+#endif // PATH_PAYOFFS_H
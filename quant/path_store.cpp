@@ -0,0 +1,261 @@
+#include "path_store.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const std::size_t kPageBytes = 4096;
+
+std::size_t round_up(std::size_t value, std::size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// True if rows * columns 8-byte values starting at byte offset fit in a file of size bytes
+bool fits(std::size_t size, std::uint64_t offset, std::uint64_t rows, std::uint64_t columns) {
+    if (offset > size) {
+        return false;
+    }
+    const std::uint64_t doubles = (size - offset) / sizeof(double);
+    return columns == 0 || rows <= doubles / columns;
+}
+
+std::runtime_error system_error(const std::string& what, const std::string& filename) {
+    return std::runtime_error(what + " " + filename + ": " + std::strerror(errno));
+}
+
+// A writable shared mapping of a file, unmapped and closed on scope exit
+class WritableMapping {
+public:
+    WritableMapping(const std::string& filename, std::size_t bytes) : size(bytes) {
+        fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw system_error("write_path_store: cannot create", filename);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            throw system_error("write_path_store: cannot size", filename);
+        }
+        void* address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw system_error("write_path_store: cannot map", filename);
+        }
+        data = static_cast<unsigned char*>(address);
+        // Chunks are written front to back: let the kernel write back and drop pages early
+        ::madvise(data, size, MADV_SEQUENTIAL);
+    }
+
+    ~WritableMapping() {
+        ::munmap(data, size);
+        ::close(fd);
+    }
+
+    WritableMapping(const WritableMapping&) = delete;
+    WritableMapping& operator=(const WritableMapping&) = delete;
+
+    void flush() {
+        ::msync(data, size, MS_SYNC);
+    }
+
+    unsigned char* data = nullptr;
+
+private:
+    std::size_t size;
+    int fd = -1;
+};
+
+} // namespace
+
+PathStoreHeader write_path_store(MonteCarloEngine& engine, const GbmParameters& params, std::size_t num_paths,
+                                 const std::vector<std::size_t>& observation_steps, const std::string& filename) {
+    // The same normalization as the engine's observation grid
+    const std::size_t steps = static_cast<std::size_t>(std::max(params.steps, 1));
+    std::vector<std::size_t> observed = observation_steps;
+    if (observed.empty()) {
+        for (std::size_t s = 1; s <= steps; ++s) {
+            observed.push_back(s);
+        }
+    }
+    for (std::size_t& step : observed) {
+        step = std::min(std::max<std::size_t>(step, 1), steps);
+    }
+    std::sort(observed.begin(), observed.end());
+    observed.erase(std::unique(observed.begin(), observed.end()), observed.end());
+    const std::size_t num_observations = observed.size();
+    const VarianceReduction& reduction = engine.variance_reduction();
+    const bool quasi_random = engine.sampling() == SamplingMode::QuasiRandom;
+    const bool has_weights = reduction.importance_shift != 0.0;
+    const std::size_t num_columns = num_observations + (has_weights ? 1 : 0);
+
+    PathStoreHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kPathStoreMagic, sizeof(header.magic));
+    header.version = kPathStoreVersion;
+    header.num_paths = num_paths;
+    header.num_observations = num_observations;
+    header.chunk_paths = engine.block_size();
+    header.steps_offset = round_up(sizeof(PathStoreHeader), 64);
+    header.data_offset = round_up(header.steps_offset + num_observations * sizeof(std::uint64_t), kPageBytes);
+    header.file_bytes = header.data_offset + num_paths * num_columns * sizeof(double);
+    header.seed = engine.seed();
+    header.steps = steps;
+    header.S0 = params.S0;
+    header.mu = params.mu;
+    header.sigma = params.sigma;
+    header.T = params.T;
+    header.sampling = static_cast<std::uint32_t>(engine.sampling());
+    header.antithetic = (reduction.antithetic && !quasi_random) ? 1 : 0;
+    header.exact_terminal = engine.exact_terminal() ? 1 : 0;
+    header.has_weights = has_weights ? 1 : 0;
+    header.importance_shift = reduction.importance_shift;
+
+    WritableMapping file(filename, header.file_bytes);
+    std::memcpy(file.data, &header, sizeof(header));
+    std::uint64_t* step_table = reinterpret_cast<std::uint64_t*>(file.data + header.steps_offset);
+    std::vector<std::size_t> column_of(steps + 1, num_observations);
+    for (std::size_t k = 0; k < num_observations; ++k) {
+        step_table[k] = observed[k];
+        column_of[observed[k]] = k;
+    }
+
+    double* prices_base = reinterpret_cast<double*>(file.data + header.data_offset);
+    const std::size_t chunk_paths = header.chunk_paths;
+    // Engine blocks never straddle chunks, so each run is contiguous in column k
+    auto write_run = [&](std::size_t first_path, std::size_t k, const double* values, std::size_t count) {
+        const std::size_t chunk = first_path / chunk_paths;
+        const std::size_t chunk_start = chunk * chunk_paths;
+        const std::size_t in_chunk = std::min(chunk_paths, num_paths - chunk_start);
+        double* column = prices_base + chunk_start * num_columns + k * in_chunk;
+        std::memcpy(column + (first_path - chunk_start), values, count * sizeof(double));
+    };
+    auto observer = [&](std::size_t first_path, std::size_t step, const double* prices, std::size_t count,
+                        unsigned) {
+        const std::size_t k = column_of[step];
+        if (k != num_observations) {
+            write_run(first_path, k, prices, count);
+        }
+    };
+    auto consumer = [&](std::size_t first_path, const double*, const double* weights, std::size_t count,
+                        unsigned) {
+        if (has_weights) {
+            write_run(first_path, num_observations, weights, count);
+        }
+    };
+    engine.for_each_observed_block(params, num_paths, observed, observer, consumer);
+
+    // Readers reject the file until this flag is set
+    header.complete = 1;
+    std::memcpy(file.data, &header, sizeof(header));
+    file.flush();
+    return header;
+}
+
+PathStore::PathStore(const std::string& filename) {
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw system_error("PathStore: cannot open", filename);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw system_error("PathStore: cannot stat", filename);
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    if (size < sizeof(PathStoreHeader)) {
+        ::close(fd);
+        throw std::runtime_error("PathStore: " + filename + " is too short to be a path store");
+    }
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);    // The mapping keeps the file open
+    if (address == MAP_FAILED) {
+        throw system_error("PathStore: cannot map", filename);
+    }
+    data = static_cast<const unsigned char*>(address);
+    head = reinterpret_cast<const PathStoreHeader*>(data);
+
+    const char* problem = nullptr;
+    if (std::memcmp(head->magic, kPathStoreMagic, sizeof(kPathStoreMagic)) != 0) {
+        problem = " is not a path store";
+    } else if (head->version != kPathStoreVersion) {
+        problem = " has an unsupported version";
+    } else if (!head->complete) {
+        problem = " was not completely written";
+    } else if (head->file_bytes > size || head->chunk_paths == 0) {
+        problem = " is truncated or corrupt";
+    } else if (!fits(size, head->steps_offset, head->num_observations, 1)) {
+        problem = " has a step table past the end of the file";
+    } else if (!fits(size, head->data_offset, head->num_paths, head->num_observations + (head->has_weights ? 1 : 0))) {
+        // num_observations is bounded by the step table check, so the column count cannot wrap
+        problem = " has price data past the end of the file";
+    }
+    if (problem) {
+        ::munmap(const_cast<unsigned char*>(data), size);
+        throw std::runtime_error("PathStore: " + filename + problem);
+    }
+    steps = reinterpret_cast<const std::uint64_t*>(data + head->steps_offset);
+    num_columns = static_cast<std::size_t>(head->num_observations) + (head->has_weights ? 1 : 0);
+}
+
+PathStore::~PathStore() {
+    ::munmap(const_cast<unsigned char*>(data), size);
+}
+
+const PathStoreHeader& PathStore::header() const {
+    return *head;
+}
+
+std::size_t PathStore::num_paths() const {
+    return static_cast<std::size_t>(head->num_paths);
+}
+
+std::size_t PathStore::num_observations() const {
+    return static_cast<std::size_t>(head->num_observations);
+}
+
+std::size_t PathStore::chunk_paths() const {
+    return static_cast<std::size_t>(head->chunk_paths);
+}
+
+std::size_t PathStore::observation_step(std::size_t k) const {
+    return static_cast<std::size_t>(steps[k]);
+}
+
+const double* PathStore::slice_run(std::size_t k, std::size_t first_path, std::size_t& count) const {
+    const std::size_t chunk_start = first_path / chunk_paths() * chunk_paths();
+    const std::size_t in_chunk = std::min(chunk_paths(), num_paths() - chunk_start);
+    count = std::min(count, chunk_start + in_chunk - first_path);
+    const double* prices = reinterpret_cast<const double*>(data + head->data_offset);
+    return prices + chunk_start * num_columns + k * in_chunk + (first_path - chunk_start);
+}
+
+bool PathStore::has_weights() const {
+    return head->has_weights != 0;
+}
+
+const double* PathStore::weight_run(std::size_t first_path, std::size_t& count) const {
+    if (!has_weights()) {
+        count = std::min(count, num_paths() - first_path);
+        return nullptr;
+    }
+    return slice_run(num_observations(), first_path, count);
+}
+
+void PathStore::read_time_slice(std::size_t k, std::size_t first_path, std::size_t count, double* out) const {
+    for_each_slice_run(k, first_path, count, [&](std::size_t path, const double* prices, std::size_t run) {
+        std::copy(prices, prices + run, out + (path - first_path));
+    });
+}
+
+void PathStore::read_path(std::size_t path, double* out) const {
+    for (std::size_t k = 0; k < num_observations(); ++k) {
+        std::size_t one = 1;
+        out[k] = *slice_run(k, path, one);
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef PATH_STORE_H
+#define PATH_STORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "monte_carlo_engine.h"
+
+constexpr char kPathStoreMagic[8] = {'Q', 'P', 'A', 'T', 'H', 'S', '0', '1'};
+constexpr std::uint32_t kPathStoreVersion = 2;
+
+/**
+ * @brief Fixed header at byte 0 of a path store file.
+ *
+ * Layout: the header, then num_observations uint64 step indices at
+ * steps_offset, then the prices from data_offset (page aligned). Prices are
+ * doubles in chunks of chunk_paths paths (the last chunk may be shorter);
+ * inside a chunk they are columnar, one contiguous column per observation,
+ * followed by a column of dP/dQ weights when has_weights is set. With
+ * C = num_observations + has_weights columns:
+ *
+ *   chunk c, column k, path p  ->  data_offset
+ *       + 8 * (c * chunk_paths * C + k * paths_in_chunk(c) + (p - c * chunk_paths))
+ *
+ * The sampling fields record how the engine drew the paths: they are only
+ * reproducible from the seed under the same settings, and under importance
+ * sampling the prices are drawn under the shifted measure, so every statistic
+ * must weight path p by its stored weight. All fields are in the writer's
+ * native byte order (little-endian on x86).
+ */
+struct PathStoreHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t complete;             // Set once every chunk is written
+    std::uint64_t num_paths;
+    std::uint64_t num_observations;
+    std::uint64_t chunk_paths;
+    std::uint64_t steps_offset;         // Byte offset of the observed 1-based step indices
+    std::uint64_t data_offset;          // Byte offset of the first chunk
+    std::uint64_t file_bytes;
+    std::uint64_t seed;                 // Engine seed: path p can be regenerated from it
+    std::uint64_t steps;                // params.steps
+    double S0;
+    double mu;
+    double sigma;
+    double T;
+    std::uint32_t sampling;             // SamplingMode the engine drew the paths with
+    std::uint32_t antithetic;           // Paths 2k and 2k + 1 are an antithetic pair
+    std::uint32_t exact_terminal;       // Only the observed steps were simulated, each exactly
+    std::uint32_t has_weights;          // Each chunk ends with a column of dP/dQ weights
+    double importance_shift;            // Mean shift of every fine-step normal (0 = none)
+};
+
+/**
+ * @brief Simulates num_paths GBM paths and streams their prices at observation_steps into filename.
+ *
+ * observation_steps are 1-based steps as in for_each_observed_block (empty
+ * means every step); they are sorted and deduplicated. The file is sized up
+ * front and mapped, and each worker copies its block straight into the block's
+ * chunk, so every chunk is filled front to back in one sequential pass. A
+ * chunk is one engine block. The engine's sampling settings go in the header,
+ * and with an importance shift each path's likelihood ratio is stored next to
+ * its prices. Throws std::runtime_error if the file cannot be created or
+ * mapped. Returns the header that was written.
+ */
+PathStoreHeader write_path_store(MonteCarloEngine& engine, const GbmParameters& params, std::size_t num_paths,
+                                 const std::vector<std::size_t>& observation_steps, const std::string& filename);
+
+/**
+ * @brief Read-only, zero-copy view of a path store file.
+ *
+ * The whole file is mapped; time slices are handed out as pointers into the
+ * mapping, one contiguous run per chunk. Throws std::runtime_error if the file
+ * cannot be mapped, is not a path store, was not completely written, or its
+ * step table or price data do not fit in the file.
+ */
+class PathStore {
+public:
+    explicit PathStore(const std::string& filename);
+    ~PathStore();
+
+    PathStore(const PathStore&) = delete;
+    PathStore& operator=(const PathStore&) = delete;
+
+    const PathStoreHeader& header() const;
+    std::size_t num_paths() const;
+    std::size_t num_observations() const;
+    std::size_t chunk_paths() const;
+
+    // The 1-based time step of observation k
+    std::size_t observation_step(std::size_t k) const;
+
+    /**
+     * @brief Prices at observation k of paths [first_path, first_path + count), zero-copy.
+     *
+     * Returns a pointer into the mapping and sets count to the number of paths
+     * the run holds: the run stops at the end of first_path's chunk.
+     */
+    const double* slice_run(std::size_t k, std::size_t first_path, std::size_t& count) const;
+
+    // Calls fn(first_path, prices, count) for each contiguous run of a path range at observation k
+    template <class Fn>
+    void for_each_slice_run(std::size_t k, std::size_t first_path, std::size_t count, Fn fn) const {
+        const std::size_t end = std::min(first_path + count, num_paths());
+        while (first_path < end) {
+            std::size_t run = end - first_path;
+            const double* prices = slice_run(k, first_path, run);
+            fn(first_path, prices, run);
+            first_path += run;
+        }
+    }
+
+    // True if the paths were drawn under an importance shift and carry dP/dQ weights
+    bool has_weights() const;
+
+    // Weights of paths [first_path, first_path + count) as in slice_run, or nullptr
+    // (every weight is 1) if the store has none
+    const double* weight_run(std::size_t first_path, std::size_t& count) const;
+
+    // Copies the prices at observation k of paths [first_path, first_path + count) into out
+    void read_time_slice(std::size_t k, std::size_t first_path, std::size_t count, double* out) const;
+
+    // Copies one path's prices at every observation into out[0, num_observations)
+    void read_path(std::size_t path, double* out) const;
+
+private:
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    const PathStoreHeader* head = nullptr;
+    const std::uint64_t* steps = nullptr;
+    std::size_t num_columns = 0;        // Observations plus the weight column, if any
+};
+
+#endif // PATH_STORE_H
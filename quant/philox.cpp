@@ -0,0 +1,137 @@
+#include "philox.h"
+
+#include <cmath>
+
+namespace {
+
+const double kTwoPi = 6.283185307179586476925;
+
+// Maps 64 random bits to a double in the open interval (0, 1)
+inline double to_open_unit(std::uint32_t high, std::uint32_t low) {
+    std::uint64_t bits = (static_cast<std::uint64_t>(high) << 32) | low;
+    return (static_cast<double>(bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+template <class Real>
+void normal_pairs(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path, std::size_t num_paths,
+                  std::uint32_t pair, Real* z0, Real* z1) {
+    for (std::size_t p = 0; p < num_paths; ++p) {
+        const std::uint64_t path = first_path + p;
+        Philox4x32::Counter counter = {pair, static_cast<std::uint32_t>(path),
+                                       static_cast<std::uint32_t>(path >> 32), stream};
+        Philox4x32::Counter bits = Philox4x32::generate(counter, key);
+
+        // Box-Muller transform of two independent uniforms, in double whatever Real is
+        double u1 = to_open_unit(bits[0], bits[1]);
+        double u2 = to_open_unit(bits[2], bits[3]);
+        double radius = std::sqrt(-2.0 * std::log(u1));
+        double angle = kTwoPi * u2;
+        if (z0) {
+            z0[p] = static_cast<Real>(radius * std::cos(angle));
+        }
+        if (z1) {
+            z1[p] = static_cast<Real>(radius * std::sin(angle));
+        }
+    }
+}
+
+// Fills a step-major block pair by pair with one of the pair kernels
+template <class Real, class Kernel>
+void fill_pairs(Kernel kernel, const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                std::size_t num_paths, std::uint32_t first_step, std::size_t num_steps, Real* out) {
+    if (num_steps == 0) {
+        return;
+    }
+    const std::uint32_t end_step = first_step + static_cast<std::uint32_t>(num_steps);
+    const std::uint32_t first_pair = first_step / 2;
+    const std::uint32_t end_pair = (end_step + 1) / 2;
+
+    // Pair-major: each call fills up to two whole step rows across all paths
+    for (std::uint32_t pair = first_pair; pair < end_pair; ++pair) {
+        const std::uint32_t even = 2 * pair;
+        Real* z0 = (even >= first_step) ? out + (even - first_step) * num_paths : nullptr;
+        Real* z1 = (even + 1 < end_step) ? out + (even + 1 - first_step) * num_paths : nullptr;
+        kernel(key, stream, first_path, num_paths, pair, z0, z1);
+    }
+}
+
+} // namespace
+
+NormalPairKernel select_normal_pair_kernel(SimdIsa isa) {
+    if (!simd_isa_supported(isa)) {
+        return normal_pairs_scalar;
+    }
+    switch (isa) {
+#if defined(QUANT_HAVE_X86_KERNELS)
+        case SimdIsa::Avx2:
+            return normal_pairs_avx2;
+        case SimdIsa::Avx512:
+            return normal_pairs_avx512;
+#endif
+        default:
+            return normal_pairs_scalar;
+    }
+}
+
+NormalPairKernelF32 select_normal_pair_kernel_f32(SimdIsa isa) {
+    if (!simd_isa_supported(isa)) {
+        return normal_pairs_scalar_f32;
+    }
+    switch (isa) {
+#if defined(QUANT_HAVE_X86_KERNELS)
+        case SimdIsa::Avx2:
+            return normal_pairs_avx2_f32;
+        case SimdIsa::Avx512:
+            return normal_pairs_avx512_f32;
+#endif
+        default:
+            return normal_pairs_scalar_f32;
+    }
+}
+
+void normal_pairs_scalar(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                         std::size_t num_paths, std::uint32_t pair, double* z0, double* z1) {
+    normal_pairs(key, stream, first_path, num_paths, pair, z0, z1);
+}
+
+void normal_pairs_scalar_f32(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                             std::size_t num_paths, std::uint32_t pair, float* z0, float* z1) {
+    normal_pairs(key, stream, first_path, num_paths, pair, z0, z1);
+}
+
+PathNormalGenerator::PathNormalGenerator(std::uint64_t seed, std::uint32_t stream, SimdIsa isa)
+    : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}, stream_id(stream),
+      pair_kernel(select_normal_pair_kernel(isa)), pair_kernel_f32(select_normal_pair_kernel_f32(isa)) {}
+
+std::uint64_t PathNormalGenerator::seed() const {
+    return (static_cast<std::uint64_t>(key[1]) << 32) | key[0];
+}
+
+std::uint32_t PathNormalGenerator::stream() const {
+    return stream_id;
+}
+
+double PathNormalGenerator::normal(std::uint64_t path, std::uint32_t step) const {
+    double z;
+    if (step % 2 == 0) {
+        pair_kernel(key, stream_id, path, 1, step / 2, &z, nullptr);
+    } else {
+        pair_kernel(key, stream_id, path, 1, step / 2, nullptr, &z);
+    }
+    return z;
+}
+
+void PathNormalGenerator::fill_path(std::uint64_t path, std::uint32_t first_step, std::size_t num_steps,
+                                    double* out) const {
+    fill_block(path, 1, first_step, num_steps, out);
+}
+
+void PathNormalGenerator::fill_block(std::uint64_t first_path, std::size_t num_paths,
+                                     std::uint32_t first_step, std::size_t num_steps, double* out) const {
+    fill_pairs(pair_kernel, key, stream_id, first_path, num_paths, first_step, num_steps, out);
+}
+
+void PathNormalGenerator::fill_block(std::uint64_t first_path, std::size_t num_paths,
+                                     std::uint32_t first_step, std::size_t num_steps, float* out) const {
+    fill_pairs(pair_kernel_f32, key, stream_id, first_path, num_paths, first_step, num_steps, out);
+}
@@ -0,0 +1,128 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "gbm_kernel.h"
+
+/**
+ * @brief Philox4x32-10 counter-based random number generator (Salmon et al., 2011).
+ *
+ * A counter-based generator has no hidden state: the output is a pure function
+ * of a 128-bit counter and a 64-bit key. Any element of the stream can be
+ * computed directly, on any thread and in any order.
+ */
+class Philox4x32 {
+public:
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    static Counter generate(Counter counter, Key key) {
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                key[0] += kWeyl0;
+                key[1] += kWeyl1;
+            }
+            std::uint64_t product0 = static_cast<std::uint64_t>(kMultiplier0) * counter[0];
+            std::uint64_t product1 = static_cast<std::uint64_t>(kMultiplier1) * counter[2];
+            counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                       static_cast<std::uint32_t>(product1),
+                       static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                       static_cast<std::uint32_t>(product0)};
+        }
+        return counter;
+    }
+
+    // Round constants, shared with the vectorized generators
+    static constexpr std::uint32_t kMultiplier0 = 0xD2511F53u;
+    static constexpr std::uint32_t kMultiplier1 = 0xCD9E8D57u;
+    static constexpr std::uint32_t kWeyl0 = 0x9E3779B9u;
+    static constexpr std::uint32_t kWeyl1 = 0xBB67AE85u;
+};
+
+/**
+ * @brief Normal pair `pair` of num_paths consecutive paths.
+ *
+ * Writes the Box-Muller normals for steps 2 * pair and 2 * pair + 1 of path
+ * first_path + p to z0[p] and z1[p]; a null row is skipped. The SIMD variants
+ * run Philox across lanes (one path per lane) and evaluate log, sin and cos
+ * with vector polynomials, so they agree with the scalar kernel to a few ulps
+ * rather than bit for bit. Every path goes through the same code whatever its
+ * position in a batch, so a generator's output never depends on block sizes.
+ */
+using NormalPairKernel = void (*)(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                                  std::size_t num_paths, std::uint32_t pair, double* z0, double* z1);
+
+// The same normals rounded once to float as they are stored, for float path engines
+using NormalPairKernelF32 = void (*)(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                                     std::size_t num_paths, std::uint32_t pair, float* z0, float* z1);
+
+// Returns the pair kernel for isa, or the scalar kernel if isa is not supported
+NormalPairKernel select_normal_pair_kernel(SimdIsa isa);
+NormalPairKernelF32 select_normal_pair_kernel_f32(SimdIsa isa);
+
+void normal_pairs_scalar(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                         std::size_t num_paths, std::uint32_t pair, double* z0, double* z1);
+void normal_pairs_avx2(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                       std::size_t num_paths, std::uint32_t pair, double* z0, double* z1);
+void normal_pairs_avx512(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                         std::size_t num_paths, std::uint32_t pair, double* z0, double* z1);
+void normal_pairs_scalar_f32(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                             std::size_t num_paths, std::uint32_t pair, float* z0, float* z1);
+void normal_pairs_avx2_f32(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                           std::size_t num_paths, std::uint32_t pair, float* z0, float* z1);
+void normal_pairs_avx512_f32(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                             std::size_t num_paths, std::uint32_t pair, float* z0, float* z1);
+
+// Steps of normals block walkers draw per fill_block() call. Even, so Philox
+// pairs and MLMC coarse steps never straddle two tiles.
+const std::size_t kStepTile = 8;
+
+/**
+ * @brief Standard normal variates addressed by (seed, path index, step).
+ *
+ * One Philox call with counter (step / 2, path, stream) gives two 64-bit
+ * uniforms, which Box-Muller turns into the normals for steps 2k and 2k + 1
+ * of that path. The stream id keeps independent sources of randomness for the
+ * same path (for example a second Brownian motion) apart.
+ *
+ * Blocks are generated pair by pair across paths, so the Philox rounds and the
+ * Box-Muller transform run a full vector of paths at a time on isa.
+ */
+class PathNormalGenerator {
+public:
+    explicit PathNormalGenerator(std::uint64_t seed, std::uint32_t stream = 0, SimdIsa isa = detect_simd_isa());
+
+    // The normal variate for one (path, step) pair
+    double normal(std::uint64_t path, std::uint32_t step) const;
+
+    // Fills out[k] with the normal for (path, first_step + k), k in [0, num_steps)
+    void fill_path(std::uint64_t path, std::uint32_t first_step, std::size_t num_steps, double* out) const;
+
+    /**
+     * @brief Fills a step-major block of normals for a batched kernel.
+     *
+     * out[s * num_paths + p] receives the normal for
+     * (first_path + p, first_step + s), for s in [0, num_steps) and p in [0, num_paths).
+     */
+    void fill_block(std::uint64_t first_path, std::size_t num_paths,
+                    std::uint32_t first_step, std::size_t num_steps, double* out) const;
+
+    // The same block in float: each normal is the double one rounded once, inside
+    // the kernel, so float engines store and load half the bytes per normal
+    void fill_block(std::uint64_t first_path, std::size_t num_paths,
+                    std::uint32_t first_step, std::size_t num_steps, float* out) const;
+
+    std::uint64_t seed() const;
+    std::uint32_t stream() const;
+
+private:
+    Philox4x32::Key key;
+    std::uint32_t stream_id;
+    NormalPairKernel pair_kernel;
+    NormalPairKernelF32 pair_kernel_f32;
+};
+
+#endif // PHILOX_H
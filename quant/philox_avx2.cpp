@@ -0,0 +1,131 @@
+// Compiled with -mavx2 -mfma; only called after a runtime CPU check.
+#include <algorithm>
+
+#include "philox.h"
+#include "simd_math.h"
+
+namespace {
+
+// 32 x 32 -> 64 bit products of every lane with m, split into high and low words
+inline void mul_hi_lo(__m256i a, std::uint32_t m, __m256i& hi, __m256i& lo) {
+    const __m256i multiplier = _mm256_set1_epi32(static_cast<int>(m));
+    const __m256i even = _mm256_mul_epu32(a, multiplier);
+    const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), multiplier);
+    hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    lo = _mm256_mullo_epi32(a, multiplier);
+}
+
+// Unsigned 32-bit lanes to double: AVX2 only converts signed ones, so flip the sign bit and add 2^31 back
+inline __m256d cvtepu32_pd(__m128i x) {
+    const __m128i flipped = _mm_xor_si128(x, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    return _mm256_add_pd(_mm256_cvtepi32_pd(flipped), _mm256_set1_pd(2147483648.0));
+}
+
+// Uniform in (0, 1) from the 64 bits high:low of four lanes, exactly as to_open_unit
+inline __m256d to_open_unit(__m128i high, __m128i low) {
+    const __m256d upper = _mm256_mul_pd(cvtepu32_pd(high), _mm256_set1_pd(1.0 / 4294967296.0));
+    const __m256d lower = _mm256_add_pd(cvtepu32_pd(_mm_srli_epi32(low, 11)), _mm256_set1_pd(0.5));
+    return _mm256_fmadd_pd(lower, _mm256_set1_pd(1.0 / 9007199254740992.0), upper);
+}
+
+inline __m128i lower_half(__m256i x) {
+    return _mm256_castsi256_si128(x);
+}
+
+inline __m128i upper_half(__m256i x) {
+    return _mm256_extracti128_si256(x, 1);
+}
+
+// Stores four normals, rounded once to float for float rows
+inline void store_full(double* out, __m256d z) {
+    _mm256_storeu_pd(out, z);
+}
+
+inline void store_full(float* out, __m256d z) {
+    _mm_storeu_ps(out, _mm256_cvtpd_ps(z));
+}
+
+template <class Real>
+void normal_pairs(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path, std::size_t num_paths,
+                  std::uint32_t pair, Real* z0, Real* z1) {
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+
+    // Eight paths per Philox batch, one per 32-bit lane
+    for (std::size_t p = 0; p < num_paths; p += 8) {
+        const std::uint64_t path = first_path + p;
+        const __m256i path_lo = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(path)));
+        __m256i c0 = _mm256_set1_epi32(static_cast<int>(pair));
+        __m256i c1 = _mm256_add_epi32(path_lo, lane);
+        // Lanes whose low word wrapped carry into the high word (unsigned compare via the sign flip)
+        const __m256i wrapped = _mm256_cmpgt_epi32(_mm256_xor_si256(path_lo, sign), _mm256_xor_si256(c1, sign));
+        __m256i c2 = _mm256_sub_epi32(_mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(path >> 32))),
+                                      wrapped);
+        __m256i c3 = _mm256_set1_epi32(static_cast<int>(stream));
+
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k0 += Philox4x32::kWeyl0;
+                k1 += Philox4x32::kWeyl1;
+            }
+            __m256i hi0, lo0, hi1, lo1;
+            mul_hi_lo(c0, Philox4x32::kMultiplier0, hi0, lo0);
+            mul_hi_lo(c2, Philox4x32::kMultiplier1, hi1, lo1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+            c1 = lo1;
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+            c3 = lo0;
+        }
+
+        // Box-Muller on four double lanes at a time
+        const std::size_t remaining = num_paths - p;
+        for (std::size_t half = 0; half < 2 && 4 * half < remaining; ++half) {
+            const __m256d u1 = half ? to_open_unit(upper_half(c0), upper_half(c1))
+                                    : to_open_unit(lower_half(c0), lower_half(c1));
+            const __m256d u2 = half ? to_open_unit(upper_half(c2), upper_half(c3))
+                                    : to_open_unit(lower_half(c2), lower_half(c3));
+            const __m256d radius = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0), simd_math::log_pd(u1)));
+            __m256d sin_angle, cos_angle;
+            simd_math::sincos_2pi_pd(u2, sin_angle, cos_angle);
+            const __m256d cos_z = _mm256_mul_pd(radius, cos_angle);
+            const __m256d sin_z = _mm256_mul_pd(radius, sin_angle);
+
+            const std::size_t offset = p + 4 * half;
+            const std::size_t lanes = std::min<std::size_t>(4, remaining - 4 * half);
+            if (lanes == 4) {
+                if (z0) {
+                    store_full(z0 + offset, cos_z);
+                }
+                if (z1) {
+                    store_full(z1 + offset, sin_z);
+                }
+                continue;
+            }
+            // A partial vector goes through a spill buffer
+            alignas(32) double cos_buffer[4], sin_buffer[4];
+            _mm256_store_pd(cos_buffer, cos_z);
+            _mm256_store_pd(sin_buffer, sin_z);
+            for (std::size_t k = 0; k < lanes; ++k) {
+                if (z0) {
+                    z0[offset + k] = static_cast<Real>(cos_buffer[k]);
+                }
+                if (z1) {
+                    z1[offset + k] = static_cast<Real>(sin_buffer[k]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+void normal_pairs_avx2(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                       std::size_t num_paths, std::uint32_t pair, double* z0, double* z1) {
+    normal_pairs(key, stream, first_path, num_paths, pair, z0, z1);
+}
+
+void normal_pairs_avx2_f32(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                           std::size_t num_paths, std::uint32_t pair, float* z0, float* z1) {
+    normal_pairs(key, stream, first_path, num_paths, pair, z0, z1);
+}
@@ -0,0 +1,114 @@
+// Compiled with -mavx512f; only called after a runtime CPU check.
+#include <algorithm>
+
+#include "philox.h"
+#include "simd_math.h"
+
+namespace {
+
+// 32 x 32 -> 64 bit products of every lane with m, split into high and low words
+inline void mul_hi_lo(__m512i a, std::uint32_t m, __m512i& hi, __m512i& lo) {
+    const __m512i multiplier = _mm512_set1_epi32(static_cast<int>(m));
+    const __m512i even = _mm512_mul_epu32(a, multiplier);
+    const __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), multiplier);
+    hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+    lo = _mm512_mullo_epi32(a, multiplier);
+}
+
+// Uniform in (0, 1) from the 64 bits high:low of eight lanes, exactly as to_open_unit
+inline __m512d to_open_unit(__m256i high, __m256i low) {
+    const __m512d upper = _mm512_mul_pd(_mm512_cvtepu32_pd(high), _mm512_set1_pd(1.0 / 4294967296.0));
+    const __m512d lower = _mm512_add_pd(_mm512_cvtepu32_pd(_mm256_srli_epi32(low, 11)), _mm512_set1_pd(0.5));
+    return _mm512_fmadd_pd(lower, _mm512_set1_pd(1.0 / 9007199254740992.0), upper);
+}
+
+inline __m256i lower_half(__m512i x) {
+    return _mm512_castsi512_si256(x);
+}
+
+inline __m256i upper_half(__m512i x) {
+    return _mm512_extracti64x4_epi64(x, 1);
+}
+
+// Stores the first `lanes` of eight normals, rounded once to float for float rows
+inline void store_lanes(double* out, std::size_t lanes, __m512d z) {
+    _mm512_mask_storeu_pd(out, static_cast<__mmask8>((1u << lanes) - 1u), z);
+}
+
+inline void store_lanes(float* out, std::size_t lanes, __m512d z) {
+    const __m256 rounded = _mm512_cvtpd_ps(z);
+    if (lanes == 8) {
+        _mm256_storeu_ps(out, rounded);
+        return;
+    }
+    alignas(32) float buffer[8];
+    _mm256_store_ps(buffer, rounded);
+    std::copy(buffer, buffer + lanes, out);
+}
+
+template <class Real>
+void normal_pairs(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path, std::size_t num_paths,
+                  std::uint32_t pair, Real* z0, Real* z1) {
+    const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    // Sixteen paths per Philox batch, one per 32-bit lane
+    for (std::size_t p = 0; p < num_paths; p += 16) {
+        const std::uint64_t path = first_path + p;
+        const __m512i path_lo = _mm512_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(path)));
+        __m512i c0 = _mm512_set1_epi32(static_cast<int>(pair));
+        __m512i c1 = _mm512_add_epi32(path_lo, lane);
+        // Lanes whose low word wrapped carry into the high word
+        const __m512i path_hi = _mm512_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(path >> 32)));
+        __m512i c2 = _mm512_mask_add_epi32(path_hi, _mm512_cmplt_epu32_mask(c1, path_lo), path_hi,
+                                           _mm512_set1_epi32(1));
+        __m512i c3 = _mm512_set1_epi32(static_cast<int>(stream));
+
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k0 += Philox4x32::kWeyl0;
+                k1 += Philox4x32::kWeyl1;
+            }
+            __m512i hi0, lo0, hi1, lo1;
+            mul_hi_lo(c0, Philox4x32::kMultiplier0, hi0, lo0);
+            mul_hi_lo(c2, Philox4x32::kMultiplier1, hi1, lo1);
+            c0 = _mm512_xor_si512(_mm512_xor_si512(hi1, c1), _mm512_set1_epi32(static_cast<int>(k0)));
+            c1 = lo1;
+            c2 = _mm512_xor_si512(_mm512_xor_si512(hi0, c3), _mm512_set1_epi32(static_cast<int>(k1)));
+            c3 = lo0;
+        }
+
+        // Box-Muller on eight double lanes at a time
+        const std::size_t remaining = num_paths - p;
+        for (std::size_t half = 0; half < 2 && 8 * half < remaining; ++half) {
+            const __m512d u1 = half ? to_open_unit(upper_half(c0), upper_half(c1))
+                                    : to_open_unit(lower_half(c0), lower_half(c1));
+            const __m512d u2 = half ? to_open_unit(upper_half(c2), upper_half(c3))
+                                    : to_open_unit(lower_half(c2), lower_half(c3));
+            const __m512d radius = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_set1_pd(-2.0), simd_math::log_pd(u1)));
+            __m512d sin_angle, cos_angle;
+            simd_math::sincos_2pi_pd(u2, sin_angle, cos_angle);
+
+            const std::size_t offset = p + 8 * half;
+            const std::size_t lanes = std::min<std::size_t>(8, remaining - 8 * half);
+            if (z0) {
+                store_lanes(z0 + offset, lanes, _mm512_mul_pd(radius, cos_angle));
+            }
+            if (z1) {
+                store_lanes(z1 + offset, lanes, _mm512_mul_pd(radius, sin_angle));
+            }
+        }
+    }
+}
+
+} // namespace
+
+void normal_pairs_avx512(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                         std::size_t num_paths, std::uint32_t pair, double* z0, double* z1) {
+    normal_pairs(key, stream, first_path, num_paths, pair, z0, z1);
+}
+
+void normal_pairs_avx512_f32(const Philox4x32::Key& key, std::uint32_t stream, std::uint64_t first_path,
+                             std::size_t num_paths, std::uint32_t pair, float* z0, float* z1) {
+    normal_pairs(key, stream, first_path, num_paths, pair, z0, z1);
+}
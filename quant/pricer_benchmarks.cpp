@@ -0,0 +1,234 @@
+// pricer_benchmarks.cpp
+// Google Benchmark suite for the pricing pipeline: normal generation, the GBM
+// step kernel, path payoff evaluation, reductions and end-to-end pricing over
+// path and thread counts. Every benchmark reports items per second, so runs
+// of two versions can be compared for throughput regressions:
+//
+//   ./pricer_benchmarks --benchmark_out=before.json --benchmark_out_format=json
+//
+// Items are normals, path steps, paths or samples as each benchmark states.
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "gbm_kernel.h"
+#include "monte_carlo_engine.h"
+#include "path_payoffs.h"
+#include "philox.h"
+#include "streaming_stats.h"
+
+namespace {
+
+const std::size_t kBlockPaths = 4096;   // One engine block
+const std::size_t kTileSteps = 8;       // One engine tile of normals
+
+// Range argument 0 of the per-ISA benchmarks
+const SimdIsa kIsas[] = {SimdIsa::Scalar, SimdIsa::Avx2, SimdIsa::Avx512};
+
+// Skips the benchmark (with a message in the output) if this CPU lacks the ISA
+bool use_isa(benchmark::State& state, SimdIsa& isa) {
+    isa = kIsas[state.range(0)];
+    state.SetLabel(simd_isa_name(isa));
+    if (!simd_isa_supported(isa)) {
+        state.SkipWithError("instruction set not supported on this CPU");
+        return false;
+    }
+    return true;
+}
+
+std::vector<double> random_normals(std::size_t n) {
+    std::mt19937 generator(42);
+    std::normal_distribution<> distribution(0.0, 1.0);
+    std::vector<double> z(n);
+    for (double& value : z) {
+        value = distribution(generator);
+    }
+    return z;
+}
+
+// --- RANDOM NUMBER GENERATION ---
+// Items: normals
+void BM_NormalFill(benchmark::State& state) {
+    SimdIsa isa;
+    if (!use_isa(state, isa)) {
+        return;
+    }
+    const PathNormalGenerator normals(42, 0, isa);
+    std::vector<double> block(kBlockPaths * kTileSteps);
+    std::uint64_t first_path = 0;
+    for (auto _ : state) {
+        normals.fill_block(first_path, kBlockPaths, 0, kTileSteps, block.data());
+        benchmark::DoNotOptimize(block.data());
+        first_path += kBlockPaths;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(block.size()));
+}
+BENCHMARK(BM_NormalFill)->DenseRange(0, 2);
+
+// --- STEP KERNEL ---
+// Items: path steps
+void BM_GbmStep(benchmark::State& state) {
+    SimdIsa isa;
+    if (!use_isa(state, isa)) {
+        return;
+    }
+    const GbmStepKernel kernel = select_gbm_step_kernel(isa);
+    const std::vector<double> z = random_normals(kBlockPaths);
+    std::vector<double> prices(kBlockPaths, 100.0);
+    const double dt = 1.0 / 252.0;
+    for (auto _ : state) {
+        // Forward and back again, so prices stay near 100 however long it runs
+        kernel(prices.data(), z.data(), kBlockPaths, 0.0, 0.2 * std::sqrt(dt));
+        kernel(prices.data(), z.data(), kBlockPaths, 0.0, -0.2 * std::sqrt(dt));
+        benchmark::DoNotOptimize(prices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * static_cast<std::int64_t>(kBlockPaths));
+}
+BENCHMARK(BM_GbmStep)->DenseRange(0, 2);
+
+void BM_GbmStepF32(benchmark::State& state) {
+    SimdIsa isa;
+    if (!use_isa(state, isa)) {
+        return;
+    }
+    const GbmStepKernelF32 kernel = select_gbm_step_kernel_f32(isa);
+    const std::vector<double> z_double = random_normals(kBlockPaths);
+    const std::vector<float> z(z_double.begin(), z_double.end());
+    std::vector<float> prices(kBlockPaths, 100.0f);
+    const float vol_sqrt_dt = static_cast<float>(0.2 * std::sqrt(1.0 / 252.0));
+    for (auto _ : state) {
+        kernel(prices.data(), z.data(), kBlockPaths, 0.0f, vol_sqrt_dt);
+        kernel(prices.data(), z.data(), kBlockPaths, 0.0f, -vol_sqrt_dt);
+        benchmark::DoNotOptimize(prices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * static_cast<std::int64_t>(kBlockPaths));
+}
+BENCHMARK(BM_GbmStepF32)->DenseRange(0, 2);
+
+// --- PAYOFF EVALUATION ---
+// Items: path steps (state updates) for a block walked over 252 steps
+template <class Payoff>
+void run_path_payoff(benchmark::State& state, const Payoff& payoff) {
+    const std::size_t steps = 252;
+    std::vector<double> prices = random_normals(kBlockPaths);
+    for (double& price : prices) {
+        price = 100.0 * std::exp(0.2 * price);
+    }
+    std::vector<double> path_state(payoff.state_size() * kBlockPaths);
+    std::vector<double> out(kBlockPaths);
+    for (auto _ : state) {
+        payoff.initialize(path_state.data(), kBlockPaths, 100.0);
+        for (std::size_t step = 0; step < steps; ++step) {
+            payoff.update(path_state.data(), prices.data(), kBlockPaths, step);
+        }
+        payoff.payoff(path_state.data(), prices.data(), kBlockPaths, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(steps * kBlockPaths));
+}
+
+void BM_AsianPayoff(benchmark::State& state) {
+    run_path_payoff(state, AsianOption(OptionType::Call, 100.0));
+}
+BENCHMARK(BM_AsianPayoff);
+
+void BM_BarrierPayoff(benchmark::State& state) {
+    run_path_payoff(state, BarrierOption(OptionType::Call, 100.0, 130.0, BarrierType::UpAndOut));
+}
+BENCHMARK(BM_BarrierPayoff);
+
+// --- REDUCTIONS ---
+// Items: samples accumulated
+void BM_RunningStats(benchmark::State& state) {
+    const std::vector<double> samples = random_normals(1 << 16);
+    for (auto _ : state) {
+        RunningStats stats;
+        for (double x : samples) {
+            stats.add(x);
+        }
+        benchmark::DoNotOptimize(stats.mean());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(samples.size()));
+}
+BENCHMARK(BM_RunningStats);
+
+void BM_CompensatedSum(benchmark::State& state) {
+    const std::vector<double> samples = random_normals(1 << 16);
+    for (auto _ : state) {
+        CompensatedSum sum;
+        for (double x : samples) {
+            sum.add(x);
+        }
+        benchmark::DoNotOptimize(sum.value());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(samples.size()));
+}
+BENCHMARK(BM_CompensatedSum);
+
+// Items: slots merged (one per block of a 2^24-path run)
+void BM_MergePairwise(benchmark::State& state) {
+    const std::vector<double> samples = random_normals(4096);
+    std::vector<RunningStats> slots(4096);
+    for (std::size_t k = 0; k < slots.size(); ++k) {
+        slots[k].add(samples[k]);
+        slots[k].add(-samples[k] * 0.5);
+    }
+    for (auto _ : state) {
+        std::vector<RunningStats> copy = slots;
+        benchmark::DoNotOptimize(merge_pairwise(copy).mean());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(slots.size()));
+}
+BENCHMARK(BM_MergePairwise);
+
+// --- END-TO-END PRICING ---
+// Arguments: paths, threads. Items: paths
+void BM_EuropeanCall(benchmark::State& state) {
+    EngineConfig config;
+    config.seed = 42;
+    config.num_threads = static_cast<unsigned>(state.range(1));
+    MonteCarloEngine engine(config);
+    GbmParameters params;
+    const std::size_t paths = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        Estimate estimate = engine.estimate(params, paths, 1, [](double S_T) {
+            return std::max(S_T - 100.0, 0.0);
+        });
+        benchmark::DoNotOptimize(estimate.value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EuropeanCall)
+    ->ArgNames({"paths", "threads"})
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// 252 stepped observations per path
+void BM_AsianCall(benchmark::State& state) {
+    EngineConfig config;
+    config.seed = 42;
+    config.num_threads = static_cast<unsigned>(state.range(1));
+    MonteCarloEngine engine(config);
+    GbmParameters params;
+    AsianOption asian(OptionType::Call, 100.0);
+    for (auto _ : state) {
+        Estimate estimate = price_path_dependent(engine, params, asian, static_cast<std::size_t>(state.range(0)));
+        benchmark::DoNotOptimize(estimate.value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsianCall)
+    ->ArgNames({"paths", "threads"})
+    ->ArgsProduct({{1 << 12, 1 << 15}, {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
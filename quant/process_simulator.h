@@ -0,0 +1,171 @@
+#ifndef PROCESS_SIMULATOR_H
+#define PROCESS_SIMULATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "gbm_kernel.h"
+#include "instrumentation.h"
+#include "monte_carlo_engine.h"
+#include "philox.h"
+#include "streaming_stats.h"
+
+/**
+ * @brief Simulates any price process on the engine's threads, block by block.
+ *
+ * The process is a template parameter, so each model gets its own inner loop
+ * with no virtual call per step. A Process provides:
+ *
+ *   std::size_t state_size() const;    // Doubles of state per path
+ *   std::size_t num_factors() const;   // Normals per path and step
+ *   void initialize(double* state, std::size_t count) const;
+ *   void step(double* state, const double* const* z, std::size_t count, double dt) const;
+ *
+ * State is structure-of-arrays over a block: variable v of path p is
+ * state[v * count + p], and variable 0 must be the asset price (multi-asset
+ * processes put one price per asset first). z[f][p] is the normal of factor
+ * f for path p at the current step.
+ *
+ * Normals come from the engine's counter-based generator, one stream per
+ * factor, so paths do not depend on the number of threads or the block size.
+ * Reductions go through the engine's reduction slots over this simulator's
+ * blocks, so a reproducible engine gives the same bits on any thread count.
+ * Paths use pseudo-random sampling without variance reduction; the engine's
+ * own GBM path keeps those features.
+ */
+template <class Process>
+class ProcessSimulator {
+public:
+    ProcessSimulator(const Process& process, MonteCarloEngine& engine) : process(process), engine(engine) {}
+
+    /**
+     * @brief Simulates num_paths paths over [0, T] in `steps` equal steps.
+     *
+     * observer, if given, sees every block's state after each step; consumer
+     * then receives the final state. Both get the whole structure-of-arrays
+     * state, whose first `count` entries are the prices. Weights are all 1.
+     */
+    void for_each_block(double T, int steps, std::size_t num_paths, const MonteCarloEngine::BlockConsumer& consumer,
+                        const MonteCarloEngine::StepObserver* observer = nullptr) const {
+        const std::size_t num_steps = static_cast<std::size_t>(std::max(steps, 1));
+        const double dt = T / static_cast<double>(num_steps);
+        const std::size_t state_size = process.state_size();
+        const std::size_t num_factors = process.num_factors();
+        const std::size_t block_size = this->block_size();
+        const std::size_t num_blocks = (num_paths + block_size - 1) / block_size;
+        std::vector<PathNormalGenerator> generators;
+        for (std::size_t f = 0; f < num_factors; ++f) {
+            generators.emplace_back(engine.seed(), static_cast<std::uint32_t>(f), engine.isa());
+        }
+
+        engine.thread_pool().parallel_for(num_blocks, [&](std::size_t block, unsigned worker) {
+            const std::size_t begin = block * block_size;
+            const std::size_t count = std::min(block_size, num_paths - begin);
+            std::vector<double> state(state_size * count);
+            std::vector<double> z(num_factors * kStepTile * count);   // z[(f * kStepTile + s) * count + p]
+            const std::vector<double> weights(count, 1.0);
+            std::vector<const double*> factors(num_factors);
+
+            process.initialize(state.data(), count);
+            for (std::size_t tile_start = 0; tile_start < num_steps; tile_start += kStepTile) {
+                const std::size_t tile_steps = std::min(kStepTile, num_steps - tile_start);
+                for (std::size_t f = 0; f < num_factors; ++f) {
+                    QUANT_PHASE_SCOPE(Phase::Rng);
+                    generators[f].fill_block(begin, count, static_cast<std::uint32_t>(tile_start), tile_steps,
+                                             &z[f * kStepTile * count]);
+                }
+                for (std::size_t s = 0; s < tile_steps; ++s) {
+                    for (std::size_t f = 0; f < num_factors; ++f) {
+                        factors[f] = &z[(f * kStepTile + s) * count];
+                    }
+                    {
+                        QUANT_PHASE_SCOPE(Phase::Step);
+                        process.step(state.data(), factors.data(), count, dt);
+                    }
+                    if (observer) {
+                        QUANT_PHASE_SCOPE(Phase::Payoff);
+                        (*observer)(begin, tile_start + s + 1, state.data(), count, worker);
+                    }
+                }
+            }
+            QUANT_PHASE_SCOPE(Phase::Payoff);
+            consumer(begin, state.data(), weights.data(), count, worker);
+        });
+    }
+
+    // Paths per block: the engine's, reduced for processes with many factors so a
+    // block's state and normals stay within kBlockDoubles
+    std::size_t block_size() const {
+        const std::size_t doubles_per_path = process.state_size() + process.num_factors() * kStepTile;
+        return std::min(engine.block_size(), std::max<std::size_t>(kBlockDoubles / doubles_per_path, 8));
+    }
+
+    // Reduction slots over this simulator's blocks (see MonteCarloEngine::reduction_slots)
+    std::size_t reduction_slots(std::size_t num_paths) const {
+        return engine.reduction_slots(num_paths, block_size());
+    }
+
+    std::size_t reduction_slot(std::size_t first_path, unsigned worker) const {
+        return engine.reduction_slot(first_path, worker, block_size());
+    }
+
+    // Estimates E[payoff(S_T)] (undiscounted) with a standard error
+    Estimate estimate(double T, int steps, std::size_t num_paths, const std::function<double(double)>& payoff) const {
+        std::vector<RunningStats> slots(reduction_slots(num_paths));
+        for_each_block(T, steps, num_paths, [&](std::size_t first_path, const double* prices, const double*,
+                                                std::size_t count, unsigned worker) {
+            RunningStats& stats = slots[reduction_slot(first_path, worker)];
+            for (std::size_t i = 0; i < count; ++i) {
+                stats.add(payoff(prices[i]));
+            }
+        });
+        const RunningStats total = merge_pairwise(slots);
+        Estimate result;
+        result.value = total.mean();
+        result.std_error = total.std_error();
+        result.num_paths = static_cast<std::size_t>(total.count());
+        return result;
+    }
+
+private:
+    // Upper bound on the doubles one block keeps in flight (8 MB)
+    static const std::size_t kBlockDoubles = std::size_t(1) << 20;
+
+    Process process;
+    MonteCarloEngine& engine;
+};
+
+// Geometric Brownian motion through the batched SIMD step kernel
+class GbmProcess {
+public:
+    GbmProcess(double S0, double mu, double sigma, SimdIsa isa = detect_simd_isa())
+        : S0(S0), mu(mu), sigma(sigma), kernel(select_gbm_step_kernel(isa)) {}
+
+    std::size_t state_size() const {
+        return 1;
+    }
+
+    std::size_t num_factors() const {
+        return 1;
+    }
+
+    void initialize(double* state, std::size_t count) const {
+        std::fill(state, state + count, S0);
+    }
+
+    void step(double* state, const double* const* z, std::size_t count, double dt) const {
+        kernel(state, z[0], count, (mu - 0.5 * sigma * sigma) * dt, sigma * std::sqrt(dt));
+    }
+
+private:
+    double S0;
+    double mu;
+    double sigma;
+    GbmStepKernel kernel;
+};
+
+#endif // PROCESS_SIMULATOR_H
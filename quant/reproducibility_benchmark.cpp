@@ -0,0 +1,233 @@
+// reproducibility_benchmark.cpp
+// Prices the same option on 1, 8 and 64 threads with and without
+// reproducible reductions, shows the bits of each result and measures what
+// the fixed reduction order costs. Then runs every pricer in reproducible
+// mode on the same thread counts and checks their bits agree, and checks a
+// book priced by price_book matches price_path_dependent under non-default
+// sampling configurations.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "aad_greeks.h"
+#include "american_option.h"
+#include "basket.h"
+#include "book_pricer.h"
+#include "european_option.h"
+#include "heston.h"
+#include "merton.h"
+#include "mlmc.h"
+#include "monte_carlo_engine.h"
+#include "option_chain.h"
+#include "path_payoffs.h"
+#include "process_simulator.h"
+
+namespace {
+
+// The IEEE-754 bit pattern of a double, for exact comparisons
+std::uint64_t bits_of(double value) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// A headline number of every pricer, computed with one engine
+std::vector<double> price_everything(MonteCarloEngine& engine) {
+    GbmParameters params;
+    params.mu = 0.05;
+    params.steps = 50;
+    const double strike = 100.0;
+    std::vector<double> values;
+
+    const EuropeanOptionResult european = price_european_option(engine, params, OptionType::Call, strike, 1 << 18);
+    values.push_back(european.price.value);
+    values.push_back(european.delta.value);
+
+    const AadGreeksResult aad = price_european_aad(engine, params, OptionType::Call, strike, 1 << 14,
+                                                   std::vector<double>{0.2, 0.25});
+    values.push_back(aad.price.value);
+    values.push_back(aad.bucket_vegas.back().value);
+
+    OptionChain chain;
+    chain.strikes = {90.0, 100.0, 110.0};
+    chain.maturities = {0.5, 1.0};
+    const PriceSurface surface = price_option_chain(engine, params, chain, 1 << 16);
+    values.push_back(surface.call(1, 1).value);
+    values.push_back(surface.put(0, 2).value);
+
+    const AmericanOptionResult american = price_american_option(engine, params, OptionType::Put, strike, 1 << 16);
+    values.push_back(american.price.value);
+
+    BasketParameters basket;
+    basket.S0.assign(4, 100.0);
+    basket.sigma.assign(4, 0.2);
+    basket.correlation.assign(16, 0.5);
+    for (std::size_t i = 0; i < 4; ++i) {
+        basket.correlation[i * 4 + i] = 1.0;
+    }
+    values.push_back(price_basket_option(engine, basket, BasketStyle::Arithmetic, OptionType::Call, strike, 1.0,
+                                         1 << 16).value);
+
+    MlmcConfig mlmc;
+    mlmc.target_rmse = 0.05;
+    values.push_back(run_mlmc(engine, params, AsianOption(OptionType::Call, strike), mlmc).value);
+
+    const auto call = [&](double S_T) { return std::max(S_T - strike, 0.0); };
+    const HestonProcess heston{HestonParameters()};
+    values.push_back(ProcessSimulator<HestonProcess>(heston, engine).estimate(1.0, 50, 1 << 16, call).value);
+    const MertonProcess merton{MertonParameters(), engine.isa()};
+    values.push_back(ProcessSimulator<MertonProcess>(merton, engine).estimate(1.0, 50, 1 << 16, call).value);
+    return values;
+}
+
+} // namespace
+
+int main() {
+    // --- 1. BENCHMARK PARAMETERS ---
+    const unsigned thread_counts[] = {1, 8, 64};
+    const std::size_t terminal_paths = std::size_t(1) << 23;   // European call, one exact step
+    const std::size_t asian_paths = 1 << 16;                   // Asian call, 252 steps
+    const int repeats = 3;                                      // Best of, for the timings
+
+    GbmParameters params;
+    params.mu = 0.05;
+    const double strike = 100.0;
+    const double discount = std::exp(-params.mu * params.T);
+    AsianOption asian(OptionType::Call, strike);
+
+    std::cout << "--- Reproducibility Benchmark ---" << std::endl;
+    std::cout << "European call on " << terminal_paths << " paths, Asian call on " << asian_paths << " paths x "
+              << params.steps << " steps" << std::endl;
+    std::cout << "---------------------------------" << std::endl;
+    std::cout << std::left << std::setw(14) << "Mode" << std::right << std::setw(8) << "Threads" << std::setw(20)
+              << "European bits" << std::setw(20) << "Asian bits" << std::setw(12) << "Euro (s)" << std::setw(12)
+              << "Asian (s)" << std::endl;
+
+    double default_european = 0.0, default_asian = 0.0;    // Single-thread timings of the default mode
+    for (bool reproducible : {false, true}) {
+        // --- 2. RUN EVERY THREAD COUNT IN THIS MODE ---
+        std::vector<std::uint64_t> european_bits, asian_bits;
+        double european_time = 0.0, asian_time = 0.0;
+        for (unsigned threads : thread_counts) {
+            EngineConfig config;
+            config.seed = 2024;
+            config.num_threads = threads;
+            config.reproducible = reproducible;
+            MonteCarloEngine engine(config);
+
+            double best_european = 1e30, best_asian = 1e30;
+            Estimate european, asian_price;
+            for (int r = 0; r < repeats; ++r) {
+                auto start_time = std::chrono::steady_clock::now();
+                european = engine.estimate(params, terminal_paths, 1, [&](double S_T) {
+                    return discount * std::max(S_T - strike, 0.0);
+                });
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+                best_european = std::min(best_european, elapsed.count());
+
+                start_time = std::chrono::steady_clock::now();
+                asian_price = price_path_dependent(engine, params, asian, asian_paths);
+                elapsed = std::chrono::steady_clock::now() - start_time;
+                best_asian = std::min(best_asian, elapsed.count());
+            }
+            european_bits.push_back(bits_of(european.value));
+            asian_bits.push_back(bits_of(asian_price.value));
+            if (threads == 1) {
+                european_time = best_european;
+                asian_time = best_asian;
+            }
+
+            // --- 3. DISPLAY ONE ROW ---
+            std::cout << std::left << std::setw(14) << (reproducible ? "reproducible" : "default") << std::right
+                      << std::setw(8) << threads << std::hex << std::setw(20) << european_bits.back()
+                      << std::setw(20) << asian_bits.back() << std::dec << std::fixed << std::setprecision(3)
+                      << std::setw(12) << best_european << std::setw(12) << best_asian << std::endl;
+        }
+        const bool identical = std::equal(european_bits.begin() + 1, european_bits.end(), european_bits.begin())
+                            && std::equal(asian_bits.begin() + 1, asian_bits.end(), asian_bits.begin());
+        std::cout << "  identical across thread counts: " << (identical ? "yes" : "no") << std::endl;
+        if (!reproducible) {
+            default_european = european_time;
+            default_asian = asian_time;
+        } else {
+            std::cout << "  overhead on 1 thread: European " << std::setprecision(1)
+                      << 100.0 * (european_time / default_european - 1.0) << "%, Asian "
+                      << 100.0 * (asian_time / default_asian - 1.0) << "%" << std::endl;
+        }
+    }
+
+    // --- 4. EVERY PRICER IN REPRODUCIBLE MODE ---
+    const char* names[] = {"European price", "European delta", "AAD price",      "AAD bucket vega",
+                           "Chain call",     "Chain put",      "American (LSM)", "Basket",
+                           "MLMC Asian",     "Heston",         "Merton"};
+    std::vector<std::vector<double>> runs;
+    for (unsigned threads : thread_counts) {
+        EngineConfig config;
+        config.seed = 2024;
+        config.num_threads = threads;
+        config.reproducible = true;
+        MonteCarloEngine engine(config);
+        runs.push_back(price_everything(engine));
+    }
+
+    std::cout << "---------------------------------" << std::endl;
+    std::cout << "Every pricer, reproducible mode (bits on 1 thread, then whether 8 and 64 agree)" << std::endl;
+    bool all_identical = true;
+    for (std::size_t i = 0; i < runs[0].size(); ++i) {
+        bool identical = true;
+        for (const std::vector<double>& run : runs) {
+            identical = identical && bits_of(run[i]) == bits_of(runs[0][i]);
+        }
+        all_identical = all_identical && identical;
+        std::cout << std::left << std::setw(18) << names[i] << std::right << std::hex << std::setw(20)
+                  << bits_of(runs[0][i]) << std::dec << std::setw(6) << (identical ? "yes" : "NO") << std::endl;
+    }
+
+    // --- 5. BOOK PRICER AGAINST PRICE_PATH_DEPENDENT ---
+    GbmParameters book_params;
+    book_params.mu = 0.05;
+    book_params.steps = 50;
+    const AsianOption book_asian(OptionType::Call, strike);
+    const BarrierOption book_barrier(OptionType::Put, strike, 80.0, BarrierType::DownAndOut);
+    const std::vector<BookEntry> book = {{book_params, &book_asian, 10000}, {book_params, &book_barrier, 7001}};
+
+    struct BookConfig {
+        const char* name;
+        EngineConfig config;
+    };
+    std::vector<BookConfig> book_configs(3);
+    book_configs[0].name = "antithetic";
+    book_configs[0].config.variance_reduction.antithetic = true;
+    book_configs[1].name = "importance shift 0.05";
+    book_configs[1].config.variance_reduction.importance_shift = 0.05;
+    book_configs[2].name = "quasi-random";
+    book_configs[2].config.sampling = SamplingMode::QuasiRandom;
+
+    std::cout << "---------------------------------" << std::endl;
+    std::cout << "price_book against price_path_dependent, reproducible mode on 8 threads" << std::endl;
+    for (BookConfig& book_config : book_configs) {
+        book_config.config.seed = 2024;
+        book_config.config.num_threads = 8;
+        book_config.config.block_size = 1000;
+        book_config.config.reproducible = true;
+        MonteCarloEngine engine(book_config.config);
+        const std::vector<Estimate> book_prices = price_book(engine, book);
+        bool identical = true;
+        for (std::size_t i = 0; i < book.size(); ++i) {
+            const Estimate direct = price_path_dependent(engine, book[i].params, *book[i].payoff, book[i].num_paths);
+            identical = identical && bits_of(direct.value) == bits_of(book_prices[i].value)
+                     && bits_of(direct.std_error) == bits_of(book_prices[i].std_error);
+        }
+        all_identical = all_identical && identical;
+        std::cout << std::left << std::setw(24) << book_config.name << std::right << std::setw(6)
+                  << (identical ? "yes" : "NO") << std::endl;
+    }
+
+    return all_identical ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+#include "risk.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "normal_math.h"
+#include "process_simulator.h"
+
+namespace {
+
+// Scenarios per work item: the block's log prices for one underlying stay in L1
+const std::size_t kScenarioBlock = 1024;
+
+// Black-Scholes constants of one option that do not depend on the scenario
+struct OptionConstants {
+    bool expired = false;
+    double log_strike = 0.0;
+    double drift = 0.0;             // (r + sigma^2 / 2) * tau
+    double inv_stdev = 0.0;         // 1 / (sigma * sqrt(tau))
+    double stdev = 0.0;             // sigma * sqrt(tau)
+    double discounted_strike = 0.0; // K * exp(-r * tau)
+};
+
+OptionConstants option_constants(const Position& position, double sigma, double rate, double tau) {
+    OptionConstants constants;
+    constants.expired = tau <= 0.0;
+    if (constants.expired) {
+        return constants;
+    }
+    constants.log_strike = std::log(position.strike);
+    constants.drift = (rate + 0.5 * sigma * sigma) * tau;
+    constants.stdev = sigma * std::sqrt(tau);
+    constants.inv_stdev = 1.0 / constants.stdev;
+    constants.discounted_strike = position.strike * std::exp(-rate * tau);
+    return constants;
+}
+
+// Value of one unit of the position at price S (log_S = log S)
+double unit_value(const Position& position, const OptionConstants& constants, double S, double log_S) {
+    if (position.instrument == InstrumentType::Stock) {
+        return S;
+    }
+    if (constants.expired) {
+        return (position.instrument == InstrumentType::Call) ? std::max(S - position.strike, 0.0)
+                                                             : std::max(position.strike - S, 0.0);
+    }
+    const double d1 = (log_S - constants.log_strike + constants.drift) * constants.inv_stdev;
+    const double call = S * normal_cdf(d1) - constants.discounted_strike * normal_cdf(d1 - constants.stdev);
+    // Put-call parity saves two more CDF evaluations
+    return (position.instrument == InstrumentType::Call) ? call : call - S + constants.discounted_strike;
+}
+
+} // namespace
+
+ScenarioSet generate_scenarios(MonteCarloEngine& engine, const BasketParameters& market, double horizon,
+                               std::size_t num_scenarios) {
+    ScenarioSet scenarios;
+    scenarios.num_underlyings = market.S0.size();
+    scenarios.num_scenarios = num_scenarios;
+    scenarios.horizon = horizon;
+    scenarios.prices.resize(scenarios.num_underlyings * num_scenarios);
+
+    ProcessSimulator<BasketProcess> simulator(BasketProcess(market, engine.isa()), engine);
+    simulator.for_each_block(horizon, 1, num_scenarios, [&](std::size_t first_path, const double* prices,
+                                                            const double*, std::size_t count, unsigned) {
+        for (std::size_t u = 0; u < scenarios.num_underlyings; ++u) {
+            std::copy(prices + u * count, prices + (u + 1) * count,
+                      scenarios.prices.begin() + u * num_scenarios + first_path);
+        }
+    });
+    return scenarios;
+}
+
+std::vector<double> revalue_portfolio(MonteCarloEngine& engine, const BasketParameters& market,
+                                      const std::vector<Position>& positions, const ScenarioSet& scenarios,
+                                      double* base_value) {
+    const std::size_t num_underlyings = scenarios.num_underlyings;
+    const std::size_t num_scenarios = scenarios.num_scenarios;
+
+    // Today's value and the horizon constants of every position
+    std::vector<OptionConstants> today(positions.size()), later(positions.size());
+    std::vector<double> base(positions.size());
+    double total = 0.0;
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        const Position& position = positions[i];
+        if (position.underlying >= num_underlyings || position.underlying >= market.S0.size()) {
+            throw std::invalid_argument("revalue_portfolio: position refers to an unknown underlying");
+        }
+        const double sigma = market.sigma[position.underlying];
+        const double S0 = market.S0[position.underlying];
+        today[i] = option_constants(position, sigma, market.r, position.maturity);
+        later[i] = option_constants(position, sigma, market.r, position.maturity - scenarios.horizon);
+        base[i] = unit_value(position, today[i], S0, std::log(S0));
+        total += position.quantity * base[i];
+    }
+    if (base_value) {
+        *base_value = total;
+    }
+
+    std::vector<double> pnl(num_scenarios, 0.0);
+    const std::size_t num_blocks = (num_scenarios + kScenarioBlock - 1) / kScenarioBlock;
+    engine.thread_pool().parallel_for(num_blocks, [&](std::size_t block, unsigned) {
+        const std::size_t begin = block * kScenarioBlock;
+        const std::size_t count = std::min(kScenarioBlock, num_scenarios - begin);
+
+        // Logs of this block's prices, taken once for all positions
+        std::vector<double> log_prices(num_underlyings * count);
+        for (std::size_t u = 0; u < num_underlyings; ++u) {
+            const double* row = &scenarios.prices[u * num_scenarios + begin];
+            for (std::size_t s = 0; s < count; ++s) {
+                log_prices[u * count + s] = std::log(row[s]);
+            }
+        }
+
+        double* block_pnl = &pnl[begin];
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            const Position& position = positions[i];
+            const double* S = &scenarios.prices[position.underlying * num_scenarios + begin];
+            const double* log_S = &log_prices[position.underlying * count];
+            const double quantity = position.quantity;
+            const double start = base[i];
+            if (position.instrument == InstrumentType::Stock) {
+                for (std::size_t s = 0; s < count; ++s) {
+                    block_pnl[s] += quantity * (S[s] - start);
+                }
+                continue;
+            }
+            for (std::size_t s = 0; s < count; ++s) {
+                block_pnl[s] += quantity * (unit_value(position, later[i], S[s], log_S[s]) - start);
+            }
+        }
+    });
+    return pnl;
+}
+
+RiskReport tail_risk(std::vector<double>& pnl, double confidence) {
+    RiskReport report;
+    report.confidence = confidence;
+    const std::size_t n = pnl.size();
+    if (n == 0) {
+        return report;
+    }
+    double sum = 0.0;
+    for (double value : pnl) {
+        sum += value;
+    }
+    report.mean_pnl = sum / static_cast<double>(n);
+
+    // The tail is the m lowest P&Ls (largest losses); nth_element puts them first
+    const double tail_fraction = std::max(1.0 - confidence, 0.0);
+    const std::size_t m = std::clamp<std::size_t>(
+        static_cast<std::size_t>(std::ceil(tail_fraction * static_cast<double>(n) - 1e-9)), 1, n);
+    std::nth_element(pnl.begin(), pnl.begin() + (m - 1), pnl.end());
+
+    double tail_sum = 0.0;
+    for (std::size_t i = 0; i < m; ++i) {
+        tail_sum += pnl[i];
+    }
+    report.value_at_risk = -pnl[m - 1];
+    report.expected_shortfall = -tail_sum / static_cast<double>(m);
+    report.tail_scenarios = m;
+    return report;
+}
+
+RiskReport portfolio_risk(MonteCarloEngine& engine, const BasketParameters& market,
+                          const std::vector<Position>& positions, const ScenarioSet& scenarios,
+                          double confidence) {
+    double base_value = 0.0;
+    std::vector<double> pnl = revalue_portfolio(engine, market, positions, scenarios, &base_value);
+    RiskReport report = tail_risk(pnl, confidence);
+    report.base_value = base_value;
+    return report;
+}
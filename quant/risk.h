@@ -0,0 +1,86 @@
+#ifndef RISK_H
+#define RISK_H
+
+#include <cstddef>
+#include <vector>
+
+#include "basket.h"
+#include "monte_carlo_engine.h"
+
+// What a position holds
+enum class InstrumentType {
+    Stock,      // Linear: worth the underlying price
+    Call,       // European call, revalued with Black-Scholes
+    Put         // European put, revalued with Black-Scholes
+};
+
+// quantity units of an instrument on one of the market's underlyings
+struct Position {
+    std::size_t underlying = 0;     // Index into the market's assets
+    InstrumentType instrument = InstrumentType::Stock;
+    double strike = 0.0;            // Options only
+    double maturity = 0.0;          // Options only, in years from today
+    double quantity = 1.0;          // Negative for short positions
+};
+
+/**
+ * @brief Market states at the risk horizon, simulated once and shared by every position.
+ *
+ * prices[u * num_scenarios + s] is the price of underlying u in scenario s,
+ * so a position reads one contiguous row.
+ */
+struct ScenarioSet {
+    std::size_t num_underlyings = 0;
+    std::size_t num_scenarios = 0;
+    double horizon = 0.0;
+    std::vector<double> prices;
+};
+
+// Tail risk of the portfolio's profit and loss over the horizon
+struct RiskReport {
+    double base_value = 0.0;            // Portfolio value today
+    double mean_pnl = 0.0;
+    double value_at_risk = 0.0;         // Loss exceeded in a fraction 1 - confidence of scenarios
+    double expected_shortfall = 0.0;    // Average loss in those scenarios
+    double confidence = 0.0;
+    std::size_t tail_scenarios = 0;     // Scenarios in the tail the shortfall averages
+};
+
+/**
+ * @brief Simulates the correlated underlyings over the horizon in one exact GBM step.
+ *
+ * Runs BasketProcess on the engine's threads, so the scenarios depend only on
+ * the engine's seed.
+ */
+ScenarioSet generate_scenarios(MonteCarloEngine& engine, const BasketParameters& market, double horizon,
+                               std::size_t num_scenarios);
+
+/**
+ * @brief Revalues every position in every scenario and returns the portfolio P&L per scenario.
+ *
+ * Work is sharded by scenario block: a worker takes a block, takes the logs
+ * of its prices once, then sweeps all positions over it, accumulating into
+ * the block's slice of the result. Options are priced with Black-Scholes at
+ * their remaining maturity with the market's volatility and rate (intrinsic
+ * value once expired); the per-position constants are hoisted out of the
+ * scenario loop. Throws std::invalid_argument for an unknown underlying.
+ */
+std::vector<double> revalue_portfolio(MonteCarloEngine& engine, const BasketParameters& market,
+                                      const std::vector<Position>& positions, const ScenarioSet& scenarios,
+                                      double* base_value = nullptr);
+
+/**
+ * @brief Value-at-risk and expected shortfall of a P&L sample.
+ *
+ * Only the worst ceil((1 - confidence) * n) scenarios matter, so they are
+ * found with a partial selection (std::nth_element, linear time) instead of
+ * a full sort. pnl is reordered.
+ */
+RiskReport tail_risk(std::vector<double>& pnl, double confidence);
+
+// Revaluation followed by tail_risk
+RiskReport portfolio_risk(MonteCarloEngine& engine, const BasketParameters& market,
+                          const std::vector<Position>& positions, const ScenarioSet& scenarios,
+                          double confidence = 0.99);
+
+#endif // RISK_H
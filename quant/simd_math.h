@@ -0,0 +1,269 @@
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+// Vectorized math helpers shared by the ISA-specific kernels.
+// Only include this from translation units compiled with the matching
+// -mavx2 / -mavx512f flags; each section is enabled by the compiler's ISA macros.
+
+#include <immintrin.h>
+
+namespace simd_math {
+
+// exp(x) = 2^n * exp(r) with n = round(x / ln2) and |r| <= ln2 / 2.
+// exp(r) is a degree-12 Taylor polynomial, accurate to about 1 ulp on that range.
+constexpr double kExpMaxArg = 709.0;
+constexpr double kExpMinArg = -708.0;
+constexpr double kLog2e = 1.4426950408889634074;
+constexpr double kLn2Hi = 6.93147180369123816490e-01;
+constexpr double kLn2Lo = 1.90821492927058770002e-10;
+constexpr double kExpCoeffs[13] = {
+    1.0,
+    1.0,
+    1.0 / 2.0,
+    1.0 / 6.0,
+    1.0 / 24.0,
+    1.0 / 120.0,
+    1.0 / 720.0,
+    1.0 / 5040.0,
+    1.0 / 40320.0,
+    1.0 / 362880.0,
+    1.0 / 3628800.0,
+    1.0 / 39916800.0,
+    1.0 / 479001600.0,
+};
+
+// Single precision: the same reduction with a degree-7 polynomial (Cephes expf
+// coefficients), accurate to about 1 ulp of a float
+constexpr float kExpMaxArgF = 88.3f;
+constexpr float kExpMinArgF = -87.3f;
+constexpr float kLog2eF = 1.44269504088896341f;
+constexpr float kLn2HiF = 0.693359375f;
+constexpr float kLn2LoF = -2.12194440e-4f;
+constexpr float kExpCoeffsF[6] = {
+    5.0000001201e-1f,
+    1.6666665459e-1f,
+    4.1665795894e-2f,
+    8.3334519073e-3f,
+    1.3981999507e-3f,
+    1.9875691500e-4f,
+};
+
+// log(x) for normal positive x (fdlibm's reduction and polynomial): x = 2^e * m
+// with m in [sqrt(2)/2, sqrt(2)), then log(m) = f - f^2/2 + s * (f^2/2 + R(s^2)),
+// f = m - 1, s = f / (2 + f). About 1 ulp.
+constexpr double kSqrt2 = 1.41421356237309504880;
+constexpr double kLogCoeffs[7] = {
+    6.666666666666735130e-01,
+    3.999999999940941908e-01,
+    2.857142874366239149e-01,
+    2.222219843214978396e-01,
+    1.818357216161805012e-01,
+    1.531383769920937332e-01,
+    1.479819860511658591e-01,
+};
+
+// sin and cos of 2 * pi * u: u is reduced exactly to t = u - q / 4 with
+// q = round(4u), the kernels below run on r = 2 * pi * t in [-pi/4, pi/4],
+// and the quadrant q picks and signs the results (fdlibm kernel coefficients)
+constexpr double kTwoPi = 6.283185307179586476925;
+constexpr double kSinCoeffs[6] = {
+    -1.66666666666666324348e-01,
+    8.33333333332248946124e-03,
+    -1.98412698298579493134e-04,
+    2.75573137070700676789e-06,
+    -2.50507602534068634195e-08,
+    1.58969099521155010221e-10,
+};
+constexpr double kCosCoeffs[6] = {
+    4.16666666666666019037e-02,
+    -1.38888888888741095749e-03,
+    2.48015872894767294178e-05,
+    -2.75573143513906633035e-07,
+    2.08757232129817482790e-09,
+    -1.13596475577881948265e-11,
+};
+
+// 2^52 as a double; OR-ing a small integer into its mantissa and subtracting
+// 2^52 converts the integer exactly
+constexpr double kTwo52 = 4503599627370496.0;
+constexpr long long kTwo52Bits = 0x4330000000000000LL;
+constexpr long long kMantissaMask = 0x000FFFFFFFFFFFFFLL;
+constexpr long long kOneBits = 0x3FF0000000000000LL;
+
+#if defined(__AVX2__) && defined(__FMA__)
+inline __m256d exp_pd(__m256d x) {
+    x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(kExpMinArg)), _mm256_set1_pd(kExpMaxArg));
+    __m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(kLog2e)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(kLn2Hi), x);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(kLn2Lo), r);
+
+    __m256d p = _mm256_set1_pd(kExpCoeffs[12]);
+    for (int k = 11; k >= 0; --k) {
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(kExpCoeffs[k]));
+    }
+
+    // Build 2^n directly in the exponent field
+    __m256i biased = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)), _mm256_set1_epi64x(1023));
+    __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+    return _mm256_mul_pd(p, scale);
+}
+
+inline __m256 exp_ps(__m256 x) {
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(kExpMinArgF)), _mm256_set1_ps(kExpMaxArgF));
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(kLog2eF)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(kLn2HiF), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(kLn2LoF), r);
+
+    // exp(r) = 1 + r + r^2 * P(r)
+    __m256 p = _mm256_set1_ps(kExpCoeffsF[5]);
+    for (int k = 4; k >= 0; --k) {
+        p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(kExpCoeffsF[k]));
+    }
+    p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+
+    __m256i biased = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    __m256 scale = _mm256_castsi256_ps(_mm256_slli_epi32(biased, 23));
+    return _mm256_mul_ps(p, scale);
+}
+
+inline __m256d log_pd(__m256d x) {
+    const __m256i bits = _mm256_castpd_si256(x);
+    __m256d e = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(kTwo52Bits))),
+        _mm256_set1_pd(kTwo52 + 1023.0));
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(kMantissaMask)),
+                                                    _mm256_set1_epi64x(kOneBits)));
+    const __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(kSqrt2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+    e = _mm256_add_pd(e, _mm256_and_pd(big, _mm256_set1_pd(1.0)));
+
+    const __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    const __m256d hfsq = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(f, f));
+    const __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+    const __m256d z = _mm256_mul_pd(s, s);
+    __m256d r = _mm256_set1_pd(kLogCoeffs[6]);
+    for (int k = 5; k >= 0; --k) {
+        r = _mm256_fmadd_pd(r, z, _mm256_set1_pd(kLogCoeffs[k]));
+    }
+    r = _mm256_mul_pd(r, z);
+    const __m256d tail = _mm256_fmadd_pd(s, _mm256_add_pd(hfsq, r), _mm256_mul_pd(e, _mm256_set1_pd(kLn2Lo)));
+    return _mm256_fmsub_pd(e, _mm256_set1_pd(kLn2Hi), _mm256_sub_pd(_mm256_sub_pd(hfsq, tail), f));
+}
+
+inline void sincos_2pi_pd(__m256d u, __m256d& sin_out, __m256d& cos_out) {
+    const __m256d q = _mm256_round_pd(_mm256_mul_pd(u, _mm256_set1_pd(4.0)),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const __m256d r = _mm256_mul_pd(_mm256_fnmadd_pd(q, _mm256_set1_pd(0.25), u), _mm256_set1_pd(kTwoPi));
+    const __m256d z = _mm256_mul_pd(r, r);
+
+    __m256d ps = _mm256_set1_pd(kSinCoeffs[5]);
+    __m256d pc = _mm256_set1_pd(kCosCoeffs[5]);
+    for (int k = 4; k >= 0; --k) {
+        ps = _mm256_fmadd_pd(ps, z, _mm256_set1_pd(kSinCoeffs[k]));
+        pc = _mm256_fmadd_pd(pc, z, _mm256_set1_pd(kCosCoeffs[k]));
+    }
+    const __m256d sin_r = _mm256_fmadd_pd(_mm256_mul_pd(r, z), ps, r);
+    const __m256d cos_r = _mm256_fmadd_pd(_mm256_mul_pd(z, z), pc,
+                                          _mm256_fnmadd_pd(_mm256_set1_pd(0.5), z, _mm256_set1_pd(1.0)));
+
+    // Quadrants 1 and 3 swap sin and cos; 1 and 2 negate cos; 2 and 3 negate sin
+    const __m256d q1 = _mm256_cmp_pd(q, _mm256_set1_pd(1.0), _CMP_EQ_OQ);
+    const __m256d q2 = _mm256_cmp_pd(q, _mm256_set1_pd(2.0), _CMP_EQ_OQ);
+    const __m256d q3 = _mm256_cmp_pd(q, _mm256_set1_pd(3.0), _CMP_EQ_OQ);
+    const __m256d swap = _mm256_or_pd(q1, q3);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d c = _mm256_blendv_pd(cos_r, sin_r, swap);
+    const __m256d s = _mm256_blendv_pd(sin_r, cos_r, swap);
+    cos_out = _mm256_xor_pd(c, _mm256_and_pd(_mm256_or_pd(q1, q2), sign));
+    sin_out = _mm256_xor_pd(s, _mm256_and_pd(_mm256_or_pd(q2, q3), sign));
+}
+#endif
+
+#if defined(__AVX512F__)
+inline __m512d exp_pd(__m512d x) {
+    x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(kExpMinArg)), _mm512_set1_pd(kExpMaxArg));
+    __m512d n = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(kLog2e)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(kLn2Hi), x);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(kLn2Lo), r);
+
+    __m512d p = _mm512_set1_pd(kExpCoeffs[12]);
+    for (int k = 11; k >= 0; --k) {
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(kExpCoeffs[k]));
+    }
+    return _mm512_scalef_pd(p, n);
+}
+
+inline __m512 exp_ps(__m512 x) {
+    x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(kExpMinArgF)), _mm512_set1_ps(kExpMaxArgF));
+    __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(kLog2eF)),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(kLn2HiF), x);
+    r = _mm512_fnmadd_ps(n, _mm512_set1_ps(kLn2LoF), r);
+
+    __m512 p = _mm512_set1_ps(kExpCoeffsF[5]);
+    for (int k = 4; k >= 0; --k) {
+        p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(kExpCoeffsF[k]));
+    }
+    p = _mm512_fmadd_ps(p, _mm512_mul_ps(r, r), _mm512_add_ps(r, _mm512_set1_ps(1.0f)));
+    return _mm512_scalef_ps(p, n);
+}
+
+inline __m512d log_pd(__m512d x) {
+    const __m512i bits = _mm512_castpd_si512(x);
+    __m512d e = _mm512_sub_pd(
+        _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(bits, 52), _mm512_set1_epi64(kTwo52Bits))),
+        _mm512_set1_pd(kTwo52 + 1023.0));
+    __m512d m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(kMantissaMask)),
+                                                    _mm512_set1_epi64(kOneBits)));
+    const __mmask8 big = _mm512_cmp_pd_mask(m, _mm512_set1_pd(kSqrt2), _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, big, m, _mm512_set1_pd(0.5));
+    e = _mm512_mask_add_pd(e, big, e, _mm512_set1_pd(1.0));
+
+    const __m512d f = _mm512_sub_pd(m, _mm512_set1_pd(1.0));
+    const __m512d hfsq = _mm512_mul_pd(_mm512_set1_pd(0.5), _mm512_mul_pd(f, f));
+    const __m512d s = _mm512_div_pd(f, _mm512_add_pd(_mm512_set1_pd(2.0), f));
+    const __m512d z = _mm512_mul_pd(s, s);
+    __m512d r = _mm512_set1_pd(kLogCoeffs[6]);
+    for (int k = 5; k >= 0; --k) {
+        r = _mm512_fmadd_pd(r, z, _mm512_set1_pd(kLogCoeffs[k]));
+    }
+    r = _mm512_mul_pd(r, z);
+    const __m512d tail = _mm512_fmadd_pd(s, _mm512_add_pd(hfsq, r), _mm512_mul_pd(e, _mm512_set1_pd(kLn2Lo)));
+    return _mm512_fmsub_pd(e, _mm512_set1_pd(kLn2Hi), _mm512_sub_pd(_mm512_sub_pd(hfsq, tail), f));
+}
+
+inline void sincos_2pi_pd(__m512d u, __m512d& sin_out, __m512d& cos_out) {
+    const __m512d q = _mm512_roundscale_pd(_mm512_mul_pd(u, _mm512_set1_pd(4.0)),
+                                           _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const __m512d r = _mm512_mul_pd(_mm512_fnmadd_pd(q, _mm512_set1_pd(0.25), u), _mm512_set1_pd(kTwoPi));
+    const __m512d z = _mm512_mul_pd(r, r);
+
+    __m512d ps = _mm512_set1_pd(kSinCoeffs[5]);
+    __m512d pc = _mm512_set1_pd(kCosCoeffs[5]);
+    for (int k = 4; k >= 0; --k) {
+        ps = _mm512_fmadd_pd(ps, z, _mm512_set1_pd(kSinCoeffs[k]));
+        pc = _mm512_fmadd_pd(pc, z, _mm512_set1_pd(kCosCoeffs[k]));
+    }
+    const __m512d sin_r = _mm512_fmadd_pd(_mm512_mul_pd(r, z), ps, r);
+    const __m512d cos_r = _mm512_fmadd_pd(_mm512_mul_pd(z, z), pc,
+                                          _mm512_fnmadd_pd(_mm512_set1_pd(0.5), z, _mm512_set1_pd(1.0)));
+
+    // Quadrants 1 and 3 swap sin and cos; 1 and 2 negate cos; 2 and 3 negate sin
+    const __mmask8 q1 = _mm512_cmp_pd_mask(q, _mm512_set1_pd(1.0), _CMP_EQ_OQ);
+    const __mmask8 q2 = _mm512_cmp_pd_mask(q, _mm512_set1_pd(2.0), _CMP_EQ_OQ);
+    const __mmask8 q3 = _mm512_cmp_pd_mask(q, _mm512_set1_pd(3.0), _CMP_EQ_OQ);
+    const __mmask8 swap = q1 | q3;
+    const __m512d c = _mm512_mask_blend_pd(swap, cos_r, sin_r);
+    const __m512d s = _mm512_mask_blend_pd(swap, sin_r, cos_r);
+    // Negation through 0 - x keeps to AVX-512F (the xor of doubles needs DQ)
+    cos_out = _mm512_mask_sub_pd(c, q1 | q2, _mm512_setzero_pd(), c);
+    sin_out = _mm512_mask_sub_pd(s, q2 | q3, _mm512_setzero_pd(), s);
+}
+#endif
+
+} // namespace simd_math
+
+#endif // SIMD_MATH_H
@@ -0,0 +1,228 @@
+#include "sobol.h"
+
+namespace {
+
+// Joe & Kuo (new-joe-kuo-6.21201) data for the leading dimensions 1..12:
+// polynomial degree, interior coefficients a, and initial direction numbers m_k.
+struct InitialNumbers {
+    int degree;
+    std::uint32_t a;
+    std::uint32_t m[5];
+};
+
+const InitialNumbers kJoeKuo[] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+};
+const std::size_t kJoeKuoCount = sizeof(kJoeKuo) / sizeof(kJoeKuo[0]);
+
+std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+int parity(std::uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return static_cast<int>(x & 1u);
+}
+
+int count_trailing_zeros(std::uint64_t x) {
+    int n = 0;
+    while ((x & 1u) == 0) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+}
+
+// Multiplies two polynomials over GF(2) modulo poly (of the given degree)
+std::uint32_t gf2_mulmod(std::uint32_t a, std::uint32_t b, std::uint32_t poly, int degree) {
+    std::uint32_t result = 0;
+    while (b) {
+        if (b & 1u) {
+            result ^= a;
+        }
+        b >>= 1;
+        a <<= 1;
+        if (a & (1u << degree)) {
+            a ^= poly;
+        }
+    }
+    return result;
+}
+
+std::uint32_t gf2_powmod(std::uint32_t base, std::uint64_t exponent, std::uint32_t poly, int degree) {
+    std::uint32_t result = 1;
+    while (exponent) {
+        if (exponent & 1u) {
+            result = gf2_mulmod(result, base, poly, degree);
+        }
+        base = gf2_mulmod(base, base, poly, degree);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+// A polynomial is primitive when x has multiplicative order 2^degree - 1 modulo it
+bool is_primitive(std::uint32_t poly, int degree) {
+    const std::uint64_t order = (1ull << degree) - 1;
+    const std::uint32_t x = (degree == 1) ? 1u : 2u;
+    if (gf2_powmod(x, order, poly, degree) != 1u) {
+        return false;
+    }
+    std::uint64_t remaining = order;
+    for (std::uint64_t factor = 2; factor * factor <= remaining; ++factor) {
+        if (remaining % factor != 0) {
+            continue;
+        }
+        if (gf2_powmod(x, order / factor, poly, degree) == 1u) {
+            return false;
+        }
+        while (remaining % factor == 0) {
+            remaining /= factor;
+        }
+    }
+    if (remaining > 1 && gf2_powmod(x, order / remaining, poly, degree) == 1u) {
+        return false;
+    }
+    return true;
+}
+
+// The first count primitive polynomials, ordered by degree and then by value
+std::vector<std::uint32_t> primitive_polynomials(std::size_t count, std::vector<int>& degrees) {
+    std::vector<std::uint32_t> polys;
+    for (int degree = 1; polys.size() < count && degree < 31; ++degree) {
+        for (std::uint32_t a = 0; a < (1u << (degree - 1)) && polys.size() < count; ++a) {
+            std::uint32_t poly = (1u << degree) | (a << 1) | 1u;
+            if (is_primitive(poly, degree)) {
+                polys.push_back(poly);
+                degrees.push_back(degree);
+            }
+        }
+    }
+    return polys;
+}
+
+} // namespace
+
+SobolSequence::SobolSequence(std::size_t dimensions, std::uint64_t scramble_seed)
+    : dims(dimensions), directions(dimensions * kBits), shift(dimensions, 0) {
+    if (dims == 0) {
+        return;
+    }
+
+    // Dimension 0: van der Corput
+    for (int k = 0; k < kBits; ++k) {
+        directions[k] = 1u << (kBits - 1 - k);
+    }
+
+    std::vector<int> degrees;
+    std::vector<std::uint32_t> polys = primitive_polynomials(dims - 1, degrees);
+    std::uint64_t initial_state = 0x5EED50B0ull;
+
+    for (std::size_t d = 1; d < dims; ++d) {
+        const std::uint32_t poly = polys[d - 1];
+        const int s = degrees[d - 1];
+        const std::uint32_t a = (poly >> 1) & ((1u << (s - 1)) - 1u);
+
+        std::uint64_t m[kBits + 1] = {0};
+        const bool tabulated = d - 1 < kJoeKuoCount && kJoeKuo[d - 1].degree == s && kJoeKuo[d - 1].a == a;
+        for (int k = 1; k <= s && k <= kBits; ++k) {
+            if (tabulated) {
+                m[k] = kJoeKuo[d - 1].m[k - 1];
+            } else {
+                // Any odd m_k < 2^k is valid
+                m[k] = ((splitmix64(initial_state) % (1ull << (k - 1))) << 1) | 1u;
+            }
+        }
+        for (int k = s + 1; k <= kBits; ++k) {
+            std::uint64_t value = m[k - s] ^ (m[k - s] << s);
+            for (int j = 1; j < s; ++j) {
+                if ((a >> (s - 1 - j)) & 1u) {
+                    value ^= m[k - j] << j;
+                }
+            }
+            m[k] = value;
+        }
+        for (int k = 1; k <= kBits; ++k) {
+            directions[d * kBits + k - 1] = static_cast<std::uint32_t>(m[k] << (kBits - k));
+        }
+    }
+
+    if (scramble_seed == 0) {
+        return;
+    }
+
+    // Linear matrix scramble: multiply each direction number by a random
+    // lower-triangular bit matrix with a unit diagonal, then draw a digital shift
+    std::uint64_t state = scramble_seed;
+    for (std::size_t d = 0; d < dims; ++d) {
+        std::uint32_t rows[kBits];
+        for (int i = 0; i < kBits; ++i) {
+            std::uint32_t above = (i == 0) ? 0u : (~0u << (kBits - i));
+            rows[i] = (1u << (kBits - 1 - i)) | (static_cast<std::uint32_t>(splitmix64(state)) & above);
+        }
+        for (int k = 0; k < kBits; ++k) {
+            std::uint32_t v = directions[d * kBits + k];
+            std::uint32_t scrambled = 0;
+            for (int i = 0; i < kBits; ++i) {
+                scrambled |= static_cast<std::uint32_t>(parity(rows[i] & v)) << (kBits - 1 - i);
+            }
+            directions[d * kBits + k] = scrambled;
+        }
+        shift[d] = static_cast<std::uint32_t>(splitmix64(state));
+    }
+}
+
+std::size_t SobolSequence::dimensions() const {
+    return dims;
+}
+
+void SobolSequence::fill_points(std::uint64_t first_index, std::size_t num_points, double* out) const {
+    if (num_points == 0 || dims == 0) {
+        return;
+    }
+    const double scale = 1.0 / 4294967296.0;
+
+    // Jump straight to the first point: its coordinates are the XOR of the
+    // direction numbers selected by the bits of its Gray code
+    std::vector<std::uint32_t> x(dims, 0);
+    std::uint64_t gray = first_index ^ (first_index >> 1);
+    for (int k = 0; gray != 0 && k < kBits; ++k, gray >>= 1) {
+        if (gray & 1u) {
+            for (std::size_t d = 0; d < dims; ++d) {
+                x[d] ^= directions[d * kBits + k];
+            }
+        }
+    }
+
+    for (std::size_t p = 0; p < num_points; ++p) {
+        if (p > 0) {
+            // Antonov-Saleev update: flip the direction of the lowest set bit
+            const int k = count_trailing_zeros(first_index + p);
+            for (std::size_t d = 0; d < dims; ++d) {
+                x[d] ^= directions[d * kBits + k];
+            }
+        }
+        double* point = out + p * dims;
+        for (std::size_t d = 0; d < dims; ++d) {
+            point[d] = (static_cast<double>(x[d] ^ shift[d]) + 0.5) * scale;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Scrambled Sobol low-discrepancy sequence in many dimensions.
+ *
+ * Dimension 0 is the van der Corput sequence; dimension d > 0 uses the d-th
+ * primitive polynomial over GF(2), ordered by degree as in Joe & Kuo (2008).
+ * The leading dimensions use Joe & Kuo's initial direction numbers; later ones
+ * use fixed pseudo-random odd initial numbers, which still give a valid Sobol
+ * sequence (with a Brownian bridge those dimensions carry little variance).
+ *
+ * With a non-zero scramble seed the direction numbers get a random linear
+ * matrix scramble plus a random digital shift (Matousek, 1998). Each seed is
+ * an independent randomization of the same net, which is what randomized QMC
+ * error estimates need. Seed 0 gives the plain, unscrambled sequence.
+ */
+class SobolSequence {
+public:
+    SobolSequence(std::size_t dimensions, std::uint64_t scramble_seed);
+
+    std::size_t dimensions() const;
+
+    /**
+     * @brief Fills uniforms for points [first_index, first_index + num_points).
+     *
+     * out[p * dimensions() + d] is coordinate d of point first_index + p, in
+     * the open interval (0, 1). Points are produced in Gray-code order, so any
+     * block of 2^m points starting at a multiple of 2^m is a (t, m, s)-net.
+     */
+    void fill_points(std::uint64_t first_index, std::size_t num_points, double* out) const;
+
+    static const int kBits = 32;
+
+private:
+    std::size_t dims;
+    std::vector<std::uint32_t> directions;  // directions[d * kBits + k]
+    std::vector<std::uint32_t> shift;       // Digital shift per dimension
+};
+
+#endif // SOBOL_H
@@ -0,0 +1,315 @@
+#include "streaming_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// --- RunningStats ---
+
+void RunningStats::add(double x) {
+    ++n;
+    if (n == 1) {
+        min_value = max_value = x;
+    } else {
+        min_value = std::min(min_value, x);
+        max_value = std::max(max_value, x);
+    }
+    double delta = x - mean_value;
+    mean_value += delta / static_cast<double>(n);
+    m2 += delta * (x - mean_value);
+}
+
+void RunningStats::merge(const RunningStats& other) {
+    if (other.n == 0) {
+        return;
+    }
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+    const double na = static_cast<double>(n);
+    const double nb = static_cast<double>(other.n);
+    const double delta = other.mean_value - mean_value;
+    n += other.n;
+    mean_value += delta * nb / static_cast<double>(n);
+    m2 += other.m2 + delta * delta * na * nb / static_cast<double>(n);
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+}
+
+std::uint64_t RunningStats::count() const {
+    return n;
+}
+
+double RunningStats::mean() const {
+    return mean_value;
+}
+
+double RunningStats::variance() const {
+    return (n > 1) ? m2 / static_cast<double>(n - 1) : 0.0;
+}
+
+double RunningStats::std_error() const {
+    return (n > 1) ? std::sqrt(variance() / static_cast<double>(n)) : 0.0;
+}
+
+double RunningStats::min() const {
+    return min_value;
+}
+
+double RunningStats::max() const {
+    return max_value;
+}
+
+// --- RunningCovariance ---
+
+void RunningCovariance::add(double x, double y) {
+    ++n;
+    const double inv_n = 1.0 / static_cast<double>(n);
+    const double dx = x - mx;
+    const double dy = y - my;
+    mx += dx * inv_n;
+    my += dy * inv_n;
+    m2x += dx * (x - mx);
+    m2y += dy * (y - my);
+    cxy += dx * (y - my);
+}
+
+void RunningCovariance::merge(const RunningCovariance& other) {
+    if (other.n == 0) {
+        return;
+    }
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+    const double na = static_cast<double>(n);
+    const double nb = static_cast<double>(other.n);
+    const double total = na + nb;
+    const double dx = other.mx - mx;
+    const double dy = other.my - my;
+    mx += dx * nb / total;
+    my += dy * nb / total;
+    m2x += other.m2x + dx * dx * na * nb / total;
+    m2y += other.m2y + dy * dy * na * nb / total;
+    cxy += other.cxy + dx * dy * na * nb / total;
+    n += other.n;
+}
+
+std::uint64_t RunningCovariance::count() const {
+    return n;
+}
+
+double RunningCovariance::mean_x() const {
+    return mx;
+}
+
+double RunningCovariance::mean_y() const {
+    return my;
+}
+
+double RunningCovariance::variance_x() const {
+    return (n > 1) ? m2x / static_cast<double>(n - 1) : 0.0;
+}
+
+double RunningCovariance::variance_y() const {
+    return (n > 1) ? m2y / static_cast<double>(n - 1) : 0.0;
+}
+
+double RunningCovariance::covariance() const {
+    return (n > 1) ? cxy / static_cast<double>(n - 1) : 0.0;
+}
+
+// --- CompensatedSum ---
+
+void CompensatedSum::add(double x) {
+    const double t = sum + x;
+    // Recover the low-order bits lost by whichever operand was smaller
+    if (std::fabs(sum) >= std::fabs(x)) {
+        compensation += (sum - t) + x;
+    } else {
+        compensation += (x - t) + sum;
+    }
+    sum = t;
+}
+
+void CompensatedSum::merge(const CompensatedSum& other) {
+    add(other.sum);
+    compensation += other.compensation;
+}
+
+double CompensatedSum::value() const {
+    return sum + compensation;
+}
+
+// --- ExceedanceCounter ---
+
+ExceedanceCounter::ExceedanceCounter(std::vector<double> strikes)
+    : given_strikes(std::move(strikes)), order(given_strikes.size()), bucket_counts(given_strikes.size() + 1, 0) {
+    sorted_strikes = given_strikes;
+    std::sort(sorted_strikes.begin(), sorted_strikes.end());
+    for (std::size_t i = 0; i < given_strikes.size(); ++i) {
+        order[i] = static_cast<std::size_t>(
+            std::lower_bound(sorted_strikes.begin(), sorted_strikes.end(), given_strikes[i]) - sorted_strikes.begin());
+    }
+}
+
+void ExceedanceCounter::add(double x) {
+    if (bucket_counts.empty()) {
+        bucket_counts.assign(1, 0);
+    }
+    // Number of strikes strictly below x
+    std::size_t bucket = static_cast<std::size_t>(
+        std::lower_bound(sorted_strikes.begin(), sorted_strikes.end(), x) - sorted_strikes.begin());
+    ++bucket_counts[bucket];
+    ++total;
+}
+
+void ExceedanceCounter::merge(const ExceedanceCounter& other) {
+    if (bucket_counts.empty()) {
+        *this = other;
+        return;
+    }
+    for (std::size_t k = 0; k < bucket_counts.size() && k < other.bucket_counts.size(); ++k) {
+        bucket_counts[k] += other.bucket_counts[k];
+    }
+    total += other.total;
+}
+
+const std::vector<double>& ExceedanceCounter::strikes() const {
+    return given_strikes;
+}
+
+std::uint64_t ExceedanceCounter::count_above(std::size_t strike_index) const {
+    // Samples above a strike are those with more strikes below them than its sorted position
+    std::uint64_t count = 0;
+    for (std::size_t k = order[strike_index] + 1; k < bucket_counts.size(); ++k) {
+        count += bucket_counts[k];
+    }
+    return count;
+}
+
+double ExceedanceCounter::probability_above(std::size_t strike_index) const {
+    return (total > 0) ? static_cast<double>(count_above(strike_index)) / static_cast<double>(total) : 0.0;
+}
+
+// --- QuantileSketch ---
+
+QuantileSketch::QuantileSketch(double relative_accuracy, std::size_t max_buckets)
+    : gamma((1.0 + relative_accuracy) / (1.0 - relative_accuracy)),
+      log_gamma(std::log(gamma)),
+      max_buckets(std::max<std::size_t>(max_buckets, 1)) {}
+
+int QuantileSketch::bucket_index(double magnitude) const {
+    return static_cast<int>(std::ceil(std::log(magnitude) / log_gamma));
+}
+
+double QuantileSketch::bucket_value(int index) const {
+    // Midpoint (in relative terms) of the bucket (gamma^(i-1), gamma^i]
+    return 2.0 * std::exp(index * log_gamma) / (gamma + 1.0);
+}
+
+void QuantileSketch::Store::add(int index, std::uint64_t count, std::size_t max_buckets) {
+    total += count;
+    if (counts.empty()) {
+        offset = index;
+        counts.assign(1, count);
+        return;
+    }
+    if (index < offset) {
+        const std::size_t grown = counts.size() + static_cast<std::size_t>(offset - index);
+        if (grown > max_buckets) {
+            // Too wide: fold the value into the lowest bucket we keep
+            counts[0] += count;
+            return;
+        }
+        counts.insert(counts.begin(), static_cast<std::size_t>(offset - index), 0);
+        offset = index;
+    } else if (index >= offset + static_cast<int>(counts.size())) {
+        counts.resize(static_cast<std::size_t>(index - offset) + 1, 0);
+        if (counts.size() > max_buckets) {
+            // Collapse the lowest buckets so the highest ones stay exact
+            const std::size_t excess = counts.size() - max_buckets;
+            std::uint64_t folded = 0;
+            for (std::size_t k = 0; k <= excess; ++k) {
+                folded += counts[k];
+            }
+            counts.erase(counts.begin(), counts.begin() + static_cast<std::ptrdiff_t>(excess));
+            counts[0] = folded;
+            offset += static_cast<int>(excess);
+        }
+    }
+    counts[static_cast<std::size_t>(std::max(index, offset) - offset)] += count;
+}
+
+void QuantileSketch::add(double x) {
+    const double magnitude = std::fabs(x);
+    if (magnitude < 1e-300) {
+        ++zero_count;
+    } else if (x > 0.0) {
+        positive.add(bucket_index(magnitude), 1, max_buckets);
+    } else {
+        negative.add(bucket_index(magnitude), 1, max_buckets);
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    for (std::size_t k = 0; k < other.positive.counts.size(); ++k) {
+        if (other.positive.counts[k] != 0) {
+            positive.add(other.positive.offset + static_cast<int>(k), other.positive.counts[k], max_buckets);
+        }
+    }
+    for (std::size_t k = 0; k < other.negative.counts.size(); ++k) {
+        if (other.negative.counts[k] != 0) {
+            negative.add(other.negative.offset + static_cast<int>(k), other.negative.counts[k], max_buckets);
+        }
+    }
+    zero_count += other.zero_count;
+}
+
+std::uint64_t QuantileSketch::count() const {
+    return positive.total + negative.total + zero_count;
+}
+
+double QuantileSketch::quantile(double q) const {
+    const std::uint64_t n = count();
+    if (n == 0) {
+        return 0.0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    const std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(n - 1));
+
+    // Walk the values in increasing order: large negatives, zeros, then positives
+    std::uint64_t seen = 0;
+    for (std::size_t k = negative.counts.size(); k-- > 0;) {
+        seen += negative.counts[k];
+        if (seen > rank) {
+            return -bucket_value(negative.offset + static_cast<int>(k));
+        }
+    }
+    seen += zero_count;
+    if (seen > rank) {
+        return 0.0;
+    }
+    for (std::size_t k = 0; k < positive.counts.size(); ++k) {
+        seen += positive.counts[k];
+        if (seen > rank) {
+            return bucket_value(positive.offset + static_cast<int>(k));
+        }
+    }
+    return bucket_value(positive.offset + static_cast<int>(positive.counts.size()) - 1);
+}
+
+// --- PathStatistics ---
+
+void PathStatistics::add(double x) {
+    moments.add(x);
+    exceedances.add(x);
+    quantiles.add(x);
+}
+
+void PathStatistics::merge(const PathStatistics& other) {
+    moments.merge(other.moments);
+    exceedances.merge(other.exceedances);
+    quantiles.merge(other.quantiles);
+}
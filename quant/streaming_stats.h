@@ -0,0 +1,177 @@
+#ifndef STREAMING_STATS_H
+#define STREAMING_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "instrumentation.h"
+
+/**
+ * @brief Single-pass mean, variance, min and max (Welford's algorithm).
+ *
+ * Two accumulators fed with disjoint samples merge exactly (Chan et al.),
+ * so each thread can keep its own and combine them at the end.
+ */
+class RunningStats {
+public:
+    void add(double x);
+    void merge(const RunningStats& other);
+
+    std::uint64_t count() const;
+    double mean() const;
+    double variance() const;    // Unbiased sample variance
+    double std_error() const;   // Standard error of the mean
+    double min() const;
+    double max() const;
+
+private:
+    std::uint64_t n = 0;
+    double mean_value = 0.0;
+    double m2 = 0.0;
+    double min_value = 0.0;
+    double max_value = 0.0;
+};
+
+/**
+ * @brief Single-pass means, variances and covariance of a pair (x, y).
+ *
+ * Used for control variates, where the optimal coefficient is cov(x, y) / var(x).
+ */
+class RunningCovariance {
+public:
+    void add(double x, double y);
+    void merge(const RunningCovariance& other);
+
+    std::uint64_t count() const;
+    double mean_x() const;
+    double mean_y() const;
+    double variance_x() const;
+    double variance_y() const;
+    double covariance() const;
+
+private:
+    std::uint64_t n = 0;
+    double mx = 0.0;
+    double my = 0.0;
+    double m2x = 0.0;
+    double m2y = 0.0;
+    double cxy = 0.0;
+};
+
+/**
+ * @brief A sum that carries its rounding error along (Neumaier's variant of Kahan summation).
+ *
+ * The error of adding n terms stays at a few ulps of the total instead of
+ * growing with n, which matters when many small single-precision payoffs are
+ * summed in double.
+ */
+class CompensatedSum {
+public:
+    void add(double x);
+    void merge(const CompensatedSum& other);
+    double value() const;
+
+private:
+    double sum = 0.0;
+    double compensation = 0.0;
+};
+
+/**
+ * @brief Counts how many samples end above each of a fixed set of strikes.
+ *
+ * Each sample costs one binary search and one increment, however many strikes
+ * there are; per-strike totals are suffix sums taken at query time.
+ */
+class ExceedanceCounter {
+public:
+    ExceedanceCounter() = default;
+    explicit ExceedanceCounter(std::vector<double> strikes);
+
+    void add(double x);
+    void merge(const ExceedanceCounter& other);
+
+    const std::vector<double>& strikes() const;                   // In the order given
+    std::uint64_t count_above(std::size_t strike_index) const;   // Samples with x > strike
+    double probability_above(std::size_t strike_index) const;
+
+private:
+    std::vector<double> given_strikes;
+    std::vector<double> sorted_strikes;
+    std::vector<std::size_t> order;             // order[i] = sorted position of given_strikes[i]
+    std::vector<std::uint64_t> bucket_counts;   // bucket k holds samples with exactly k strikes below them
+    std::uint64_t total = 0;
+};
+
+/**
+ * @brief Mergeable quantile sketch with relative accuracy (DDSketch, Masson et al. 2019).
+ *
+ * Values fall into logarithmic buckets of ratio gamma = (1 + a) / (1 - a), so
+ * any quantile is returned within a relative error a of a true sample value.
+ * Memory is capped at max_buckets per sign; past that the lowest buckets are
+ * collapsed, which only affects the accuracy of extreme low quantiles.
+ * Sketches with the same accuracy merge by adding bucket counts.
+ */
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double relative_accuracy = 0.005, std::size_t max_buckets = 2048);
+
+    void add(double x);
+    void merge(const QuantileSketch& other);
+
+    std::uint64_t count() const;
+    double quantile(double q) const;    // q in [0, 1]
+
+private:
+    // Dense counts for a contiguous range of bucket indices
+    struct Store {
+        std::vector<std::uint64_t> counts;
+        int offset = 0;     // Bucket index of counts[0]
+        std::uint64_t total = 0;
+
+        void add(int index, std::uint64_t count, std::size_t max_buckets);
+    };
+
+    int bucket_index(double magnitude) const;
+    double bucket_value(int index) const;
+
+    double gamma;
+    double log_gamma;
+    std::size_t max_buckets;
+    Store positive;
+    Store negative;
+    std::uint64_t zero_count = 0;
+};
+
+// Everything the pricer reports about a set of terminal prices, in O(1) memory
+struct PathStatistics {
+    RunningStats moments;
+    ExceedanceCounter exceedances;
+    QuantileSketch quantiles;
+
+    void add(double x);
+    void merge(const PathStatistics& other);
+};
+
+/**
+ * @brief Merges accumulators in a fixed pairwise tree: (0,1) (2,3) ..., then (0,2) (4,6) ..., and so on.
+ *
+ * The shape depends only on the number of parts, so the same parts always
+ * give the same bits, and rounding grows with log(n) rather than n. parts is
+ * consumed; the result is returned by value.
+ */
+template <class Accumulator>
+Accumulator merge_pairwise(std::vector<Accumulator>& parts) {
+    if (parts.empty()) {
+        return Accumulator();
+    }
+    QUANT_PHASE_SCOPE(Phase::Reduction);
+    for (std::size_t stride = 1; stride < parts.size(); stride *= 2) {
+        for (std::size_t i = 0; i + stride < parts.size(); i += 2 * stride) {
+            parts[i].merge(parts[i + stride]);
+        }
+    }
+    return parts[0];
+}
+
+#endif // STREAMING_STATS_H
@@ -0,0 +1,184 @@
+#include "thread_pool.h"
+
+#include "instrumentation.h"
+
+void SchedulerStats::merge(const SchedulerStats& other) {
+    tasks += other.tasks;
+    steals += other.steals;
+    failed_steals += other.failed_steals;
+    idle_seconds += other.idle_seconds;
+}
+
+ThreadPool::ThreadPool(unsigned num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    queues = std::vector<WorkerQueue>(num_threads);
+    counters = std::vector<WorkerCounters>(num_threads);
+    workers.reserve(num_threads - 1);
+    for (unsigned id = 1; id < num_threads; ++id) {
+        workers.emplace_back(&ThreadPool::worker_loop, this, id);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned ThreadPool::size() const {
+    return static_cast<unsigned>(workers.size()) + 1;
+}
+
+void ThreadPool::parallel_for(std::size_t num_tasks, const std::function<void(std::size_t, unsigned)>& task) {
+    if (num_tasks == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Every worker starts with an equal contiguous share
+        const std::size_t num_workers = queues.size();
+        for (std::size_t w = 0; w < num_workers; ++w) {
+            std::lock_guard<std::mutex> queue_lock(queues[w].mutex);
+            queues[w].begin = num_tasks * w / num_workers;
+            queues[w].end = num_tasks * (w + 1) / num_workers;
+        }
+        current_task = &task;
+        active_workers = static_cast<unsigned>(workers.size());
+        first_error = nullptr;
+        ++generation;
+    }
+    work_ready.notify_all();
+
+    // The calling thread works as worker 0 instead of sitting idle
+    run_tasks(0);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        work_done.wait(lock, [this] { return active_workers == 0; });
+        current_task = nullptr;
+        error = first_error;
+    }
+
+    // Whoever ran out of work early waited from then until now
+    const auto all_done = std::chrono::steady_clock::now();
+    for (WorkerCounters& worker : counters) {
+        worker.stats.idle_seconds += std::chrono::duration<double>(all_done - worker.finished).count();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+SchedulerStats ThreadPool::stats() const {
+    SchedulerStats total;
+    for (const WorkerCounters& worker : counters) {
+        total.merge(worker.stats);
+    }
+    return total;
+}
+
+std::vector<SchedulerStats> ThreadPool::worker_stats() const {
+    std::vector<SchedulerStats> result;
+    for (const WorkerCounters& worker : counters) {
+        result.push_back(worker.stats);
+    }
+    return result;
+}
+
+void ThreadPool::reset_stats() {
+    for (WorkerCounters& worker : counters) {
+        worker.stats = SchedulerStats();
+    }
+}
+
+void ThreadPool::worker_loop(unsigned worker_id) {
+    std::uint64_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+        }
+
+        run_tasks(worker_id);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--active_workers == 0) {
+            work_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run_tasks(unsigned worker_id) {
+    WorkerCounters& own = counters[worker_id];
+    std::size_t index = 0;
+    while (pop_task(worker_id, index) || steal_task(worker_id, index)) {
+        try {
+            QUANT_PHASE_SCOPE(Phase::Task);
+            (*current_task)(index, worker_id);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+        ++own.stats.tasks;
+    }
+    own.finished = std::chrono::steady_clock::now();
+}
+
+bool ThreadPool::pop_task(unsigned worker_id, std::size_t& index) {
+    WorkerQueue& queue = queues[worker_id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.begin == queue.end) {
+        return false;
+    }
+    index = queue.begin++;
+    return true;
+}
+
+bool ThreadPool::steal_task(unsigned worker_id, std::size_t& index) {
+    const std::size_t num_workers = queues.size();
+    WorkerCounters& own = counters[worker_id];
+    for (std::size_t k = 1; k < num_workers; ++k) {
+        WorkerQueue& victim = queues[(worker_id + k) % num_workers];
+        std::size_t begin = 0, end = 0;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            const std::size_t remaining = victim.end - victim.begin;
+            if (remaining == 0) {
+                ++own.stats.failed_steals;
+                continue;
+            }
+            // Take the back half (rounded up), so a single remaining task moves too
+            end = victim.end;
+            begin = end - (remaining + 1) / 2;
+            victim.end = begin;
+        }
+        ++own.stats.steals;
+
+        // Run the first stolen task now and leave the rest where others can steal them
+        WorkerQueue& queue = queues[worker_id];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.begin = begin + 1;
+        queue.end = end;
+        index = begin;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,100 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// What the scheduler did, per worker or summed over the pool
+struct SchedulerStats {
+    std::uint64_t tasks = 0;            // Tasks run
+    std::uint64_t steals = 0;           // Successful steals from another worker's deque
+    std::uint64_t failed_steals = 0;    // Visits to a victim whose deque was already empty
+    double idle_seconds = 0.0;          // Time spent out of work while others were still busy
+
+    void merge(const SchedulerStats& other);
+};
+
+/**
+ * @brief A fixed-size pool of worker threads that runs indexed tasks in parallel.
+ *
+ * The calling thread takes part in every parallel_for as worker 0, so a pool
+ * of size N spawns N - 1 background threads (a pool of size 1 runs inline).
+ *
+ * Scheduling is work stealing. Each worker starts with an equal contiguous
+ * share of the task indices in its own deque and takes tasks from the front.
+ * A worker whose deque runs dry visits the others in turn and steals the back
+ * half of the first non-empty one, so when a few tasks are far slower than the
+ * rest, their owner keeps them while everyone else takes over its remaining
+ * work. Tasks own their outputs by index, so which worker ran a task never
+ * changes a result.
+ */
+class ThreadPool {
+public:
+    // Creates a pool with num_threads workers (0 means one per hardware thread)
+    explicit ThreadPool(unsigned num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of workers, including the calling thread
+    unsigned size() const;
+
+    /**
+     * @brief Runs task(index, worker_id) for every index in [0, num_tasks).
+     *
+     * Blocks until every task has finished. worker_id is in [0, size()) and is
+     * stable for the duration of one task, so it can index per-worker scratch
+     * space. The first exception thrown by a task is rethrown here.
+     * Not reentrant: a task must not call parallel_for on the same pool.
+     */
+    void parallel_for(std::size_t num_tasks, const std::function<void(std::size_t, unsigned)>& task);
+
+    // Counters since construction or the last reset_stats(); call between parallel_for calls
+    SchedulerStats stats() const;
+    std::vector<SchedulerStats> worker_stats() const;
+    void reset_stats();
+
+private:
+    // A worker's deque of task indices [begin, end). Indices are contiguous, so
+    // the deque is a range: the owner pops begin, a thief splits off the back.
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    // Written only by its worker while tasks run
+    struct alignas(64) WorkerCounters {
+        SchedulerStats stats;
+        std::chrono::steady_clock::time_point finished;
+    };
+
+    void worker_loop(unsigned worker_id);
+    void run_tasks(unsigned worker_id);
+    bool pop_task(unsigned worker_id, std::size_t& index);
+    bool steal_task(unsigned worker_id, std::size_t& index);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+
+    std::vector<WorkerQueue> queues;
+    std::vector<WorkerCounters> counters;
+
+    const std::function<void(std::size_t, unsigned)>* current_task = nullptr;
+    unsigned active_workers = 0;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+    std::exception_ptr first_error;
+};
+
+#endif // THREAD_POOL_H